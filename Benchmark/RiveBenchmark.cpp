@@ -0,0 +1,643 @@
+// Headless frame-time benchmark. Plays every artboard and state machine of the given
+// .riv files (Content/ by default) for a fixed number of frames and prints percentiles
+// of advance, tessellation and submission time, triangles and heap allocations per frame.
+//
+// Usage: rive_benchmark [--frames N] [--warmup N] [--raster WxH] [--instances N] [--serial]
+//                       [--tessellate-all | --check-fast-paths] [--stress THREADS] [--check-kernels]
+//                       [--check-save] [file.riv | directory ...]
+//
+// Without --raster the renderer draws into a sink that drops everything, so only the
+// runtime's own work is measured. With it, frames go through AxmolSoftwareSink and the
+// rasterization is part of the submit time. A synthetic scene where one paint strokes two
+// paths runs before the files. --instances plays N copies of each scene in a
+// grid through AxmolRiveScheduler. --serial advances and tessellates on the main thread
+// instead of the AxmolJobs pool. --tessellate-all sends convex fills and rectangles through
+// the general tessellator too, --check-fast-paths compares their coverage with it and fails
+// the run on any mismatch.
+//
+// --check-kernels compares the SIMD kernels to their scalar references on random input
+// instead of benchmarking, and fails on any difference beyond rounding. --check-save renders a
+// 50% alpha fill through AxmolSoftwareSink, saves it as PNG and checks the pixels read back.
+//
+// --stress imports and plays every file on several threads at once through one factory
+// instead of benchmarking, then draws groups of clips and shapes sharing sub paths, as a data
+// race check for ThreadSanitizer builds:
+//
+//   cmake -S . -B build-tsan -DAXRIVE_TSAN=ON
+//   cmake --build build-tsan --target rive_benchmark
+//   TSAN_OPTIONS=halt_on_error=1 rive_benchmark --stress 8 Content
+//
+// A clean run prints "stress: 8 threads, ok" and exits with 0.
+
+#include "AxmolRive.h"
+#include "AxmolSoftwareSink.h"
+#include "AxmolKernels.h"
+#include "AxmolJobs.h"
+#include "AxmolRiveScheduler.h"
+#include "AxmolFileMapping.h"
+
+#include "rive/file.hpp"
+#include "rive/artboard.hpp"
+#include "rive/animation/linear_animation_instance.hpp"
+#include "rive/animation/state_machine_instance.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <new>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef RIVE_BENCHMARK_CONTENT_DIR
+#    define RIVE_BENCHMARK_CONTENT_DIR "Content"
+#endif
+
+// Every operator new in the process is counted, allocations per frame are the difference
+static std::atomic<uint64_t> s_allocationCount{0};
+
+void* operator new(std::size_t size) {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+// Accepts everything and draws nothing
+class NullSink : public AxmolRenderSink {
+public:
+    void clear() override {}
+    void drawMesh(AxmolGpuMesh*, const rive::Mat2D&, ax::Color32, const AxmolGradientUniforms*) override {}
+    void drawTriangles(rive::Span<const rive::Vec2D>, rive::Span<const uint16_t>, const rive::Mat2D&,
+                       const AxmolRenderShader*) override {}
+    void drawStrip(rive::Span<const rive::Vec2D>, const rive::Mat2D&, ax::Color32,
+                   const AxmolGradientUniforms*) override {}
+    void drawStrip(rive::Span<const rive::Vec2D>, const rive::Mat2D&, const AxmolRenderShader*) override {}
+    void drawImage(const AxmolRenderImage*, rive::Span<const rive::Vec2D>, rive::Span<const rive::Vec2D>,
+                   rive::Span<const uint16_t>, const rive::Mat2D&, float) override {}
+    void setClips(const std::vector<AxmolClip>&) override {}
+    void setBlendMode(rive::BlendMode) override {}
+    size_t getDrawCallCount() const override { return 0; }
+};
+
+struct Options {
+    int frames = 300;
+    int warmup = 30;
+    int width = 0; // 0: no rasterization
+    int height = 0;
+    int instances = 1;
+    bool serial = false;
+    bool tessellateAll = false;
+    bool checkFastPaths = false;
+    int stressThreads = 0; // 0: benchmark
+    bool checkKernels = false;
+    bool checkSave = false;
+    std::vector<std::string> inputs;
+};
+
+// One row of the report, one value per measured frame
+struct Metric {
+    const char* name;
+    std::vector<double> values;
+};
+
+static double percentile(std::vector<double> values, double p) {
+    if (values.empty()) return 0.0;
+    std::sort(values.begin(), values.end());
+    size_t rank = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    return values[std::min(rank, values.size() - 1)];
+}
+
+static void printMetrics(const std::vector<Metric>& metrics) {
+    std::printf("  %-14s %10s %10s %10s %10s\n", "", "p50", "p90", "p99", "max");
+    for (const auto& metric : metrics) {
+        std::printf("  %-14s %10.3f %10.3f %10.3f %10.3f\n", metric.name, percentile(metric.values, 0.5),
+                    percentile(metric.values, 0.9), percentile(metric.values, 0.99),
+                    percentile(metric.values, 1.0));
+    }
+}
+
+static bool readFile(const std::string& path, std::vector<uint8_t>& bytes) {
+    std::ifstream stream(path, std::ios::binary);
+    if (!stream) return false;
+    bytes.assign(std::istreambuf_iterator<char>(stream), std::istreambuf_iterator<char>());
+    return true;
+}
+
+static std::vector<std::string> collectFiles(const std::vector<std::string>& inputs) {
+    namespace fs = std::filesystem;
+    std::vector<std::string> files;
+    for (const auto& input : inputs) {
+        std::error_code ec;
+        if (fs::is_directory(input, ec)) {
+            for (const auto& entry : fs::directory_iterator(input, ec)) {
+                if (entry.path().extension() == ".riv") files.push_back(entry.path().string());
+            }
+        } else {
+            files.push_back(input);
+        }
+    }
+    std::sort(files.begin(), files.end());
+    return files;
+}
+
+// Plays one artboard with one state machine (or its first animation when sm < 0)
+static void runScene(const Options& options, AxmolRenderer& renderer, rive::File& file, size_t artboardIndex,
+                     int sm) {
+    auto artboard = file.artboardAt(artboardIndex);
+    if (!artboard) return;
+
+    std::string sceneName = "(static)";
+    if (sm >= 0) {
+        sceneName = artboard->stateMachineNameAt(sm);
+    } else if (artboard->animationCount() > 0) {
+        sceneName = artboard->animationNameAt(0);
+    }
+
+    const float width = options.width > 0 ? options.width : artboard->width();
+    const float height = options.height > 0 ? options.height : artboard->height();
+
+    // Instances in a grid filling the output, each with its own state
+    AxmolRiveScheduler scheduler;
+    scheduler.setParallel(!options.serial);
+    int columns = 1;
+    while (columns * columns < options.instances) ++columns;
+    int rows = (options.instances + columns - 1) / columns;
+    for (int i = 0; i < options.instances; ++i) {
+        auto instanceArtboard = file.artboardAt(artboardIndex);
+        std::unique_ptr<rive::StateMachineInstance> stateMachine;
+        std::unique_ptr<rive::LinearAnimationInstance> animation;
+        if (sm >= 0) {
+            stateMachine = instanceArtboard->stateMachineAt(sm);
+        } else if (instanceArtboard->animationCount() > 0) {
+            animation = instanceArtboard->animationAt(0);
+        }
+        auto instance = scheduler.add(std::move(instanceArtboard), std::move(stateMachine), std::move(animation));
+        float cellWidth = width / columns;
+        float cellHeight = height / rows;
+        float x = (i % columns) * cellWidth;
+        float y = (i / columns) * cellHeight;
+        instance->frame = rive::AABB(x, y, x + cellWidth, y + cellHeight);
+    }
+
+    std::vector<Metric> metrics = {
+        {"advance ms", {}},   {"tessellate ms", {}}, {"submit ms", {}}, {"frame ms", {}},
+        {"triangles", {}},    {"draws", {}},         {"culled", {}},    {"tess jobs", {}},
+        {"allocations", {}},  {"inst max ms", {}},   {"fast fills", {}},
+    };
+
+    const float dt = 1.0f / 60.0f;
+    using Clock = std::chrono::steady_clock;
+
+    for (int frame = 0; frame < options.warmup + options.frames; ++frame) {
+        uint64_t allocationsBefore = s_allocationCount.load(std::memory_order_relaxed);
+        auto frameStart = Clock::now();
+        renderer.startFrame();
+        renderer.setCullRect(rive::AABB(0, 0, width, height));
+        auto advanceStart = Clock::now();
+        scheduler.advance(dt);
+        auto advanceEnd = Clock::now();
+
+        scheduler.draw(&renderer);
+        renderer.endFrame();
+        auto frameEnd = Clock::now();
+
+        if (frame < options.warmup) continue;
+
+        double slowest = 0.0;
+        for (size_t i = 0; i < scheduler.size(); ++i) {
+            slowest = std::max(slowest, scheduler.at(i)->advanceSeconds);
+        }
+
+        const auto& stats = renderer.getStats();
+        double advanceMs = std::chrono::duration<double, std::milli>(advanceEnd - advanceStart).count();
+        metrics[0].values.push_back(advanceMs);
+        metrics[1].values.push_back(stats.tessellationSeconds * 1000.0);
+        metrics[2].values.push_back((stats.drawSeconds - stats.tessellationSeconds) * 1000.0);
+        metrics[3].values.push_back(std::chrono::duration<double, std::milli>(frameEnd - frameStart).count());
+        metrics[4].values.push_back(static_cast<double>(stats.triangleCount));
+        metrics[5].values.push_back(stats.drawPathCount + stats.drawImageCount + stats.clipPathCount);
+        metrics[6].values.push_back(stats.culledCount);
+        metrics[7].values.push_back(stats.tessellationJobCount);
+        metrics[8].values.push_back(
+            static_cast<double>(s_allocationCount.load(std::memory_order_relaxed) - allocationsBefore));
+        metrics[9].values.push_back(slowest * 1000.0);
+        metrics[10].values.push_back(stats.fastPathCount);
+    }
+
+    std::printf("%s / %s (%d frames, %d instances)\n", artboard->name().c_str(), sceneName.c_str(), options.frames,
+                options.instances);
+    printMetrics(metrics);
+}
+
+// Synthetic scene: one paint stroking two paths, the way artboards reuse a stroke style across
+// shapes. The transform only wobbles within AxmolRenderPaint::StrokeRescale, so after the first
+// frame both strips should come from the paint's cache: no tessellation jobs, no allocations.
+static void runSharedStrokeScene(const Options& options, AxmolFactory& factory, AxmolRenderer& renderer) {
+    auto wave = factory.makeEmptyRenderPath();
+    wave->moveTo(20.0f, 100.0f);
+    for (int i = 0; i < 8; ++i) {
+        float x = 20.0f + i * 50.0f;
+        wave->cubicTo(x + 15.0f, 40.0f, x + 35.0f, 160.0f, x + 50.0f, 100.0f);
+    }
+    auto ring = factory.makeEmptyRenderPath();
+    ring->moveTo(220.0f, 200.0f);
+    ring->cubicTo(275.0f, 200.0f, 320.0f, 245.0f, 320.0f, 300.0f);
+    ring->cubicTo(320.0f, 355.0f, 275.0f, 400.0f, 220.0f, 400.0f);
+    ring->cubicTo(165.0f, 400.0f, 120.0f, 355.0f, 120.0f, 300.0f);
+    ring->cubicTo(120.0f, 245.0f, 165.0f, 200.0f, 220.0f, 200.0f);
+    ring->close();
+    auto paint = factory.makeRenderPaint();
+    paint->style(rive::RenderPaintStyle::stroke);
+    paint->color(0xFF3080F0);
+    paint->thickness(12.0f);
+    paint->join(rive::StrokeJoin::round);
+    paint->cap(rive::StrokeCap::round);
+
+    std::vector<Metric> metrics = {
+        {"tessellate ms", {}}, {"submit ms", {}}, {"triangles", {}}, {"tess jobs", {}}, {"allocations", {}},
+    };
+    for (int frame = 0; frame < options.warmup + options.frames; ++frame) {
+        uint64_t allocationsBefore = s_allocationCount.load(std::memory_order_relaxed);
+        float scale = 1.0f + 0.03f * std::sin(frame * 0.1f);
+        renderer.startFrame();
+        renderer.clearCullRect();
+        renderer.save();
+        renderer.transform(rive::Mat2D(scale, 0.0f, 0.0f, scale, 0.0f, 0.0f));
+        renderer.drawPath(wave.get(), paint.get());
+        renderer.drawPath(ring.get(), paint.get());
+        renderer.restore();
+        renderer.endFrame();
+        if (frame < options.warmup) continue;
+
+        const auto& stats = renderer.getStats();
+        metrics[0].values.push_back(stats.tessellationSeconds * 1000.0);
+        metrics[1].values.push_back((stats.drawSeconds - stats.tessellationSeconds) * 1000.0);
+        metrics[2].values.push_back(static_cast<double>(stats.triangleCount));
+        metrics[3].values.push_back(stats.tessellationJobCount);
+        metrics[4].values.push_back(
+            static_cast<double>(s_allocationCount.load(std::memory_order_relaxed) - allocationsBefore));
+    }
+
+    std::printf("\n== synthetic\nshared stroke paint / 2 paths (%d frames)\n", options.frames);
+    printMetrics(metrics);
+}
+
+// Clips and shapes contouring the same sub paths, as Rive builds them: a clipping shape's path
+// and the clipped shape's path are containers of the same shape paths. The sub paths change
+// every frame, and each group strokes with its own paint so the groups tessellate side by side.
+static void runSharedSubPaths(AxmolFactory& factory, AxmolRenderer& renderer, int frames) {
+    struct Group {
+        rive::rcp<rive::RenderPath> subPaths[2];
+        rive::rcp<rive::RenderPath> clip;
+        rive::rcp<rive::RenderPath> shape;
+        rive::rcp<rive::RenderPaint> stroke;
+    };
+    std::vector<Group> groups(8);
+    for (auto& group : groups) {
+        for (auto& subPath : group.subPaths) subPath = factory.makeEmptyRenderPath();
+        group.clip = factory.makeEmptyRenderPath();
+        group.shape = factory.makeEmptyRenderPath();
+        group.stroke = factory.makeRenderPaint();
+        group.stroke->style(rive::RenderPaintStyle::stroke);
+        group.stroke->thickness(4.0f);
+    }
+    auto fill = factory.makeRenderPaint();
+    fill->color(0xFF808080);
+
+    for (int frame = 0; frame < frames; ++frame) {
+        renderer.beginRecording();
+        for (size_t g = 0; g < groups.size(); ++g) {
+            auto& group = groups[g];
+            for (int k = 0; k < 2; ++k) {
+                // Two overlapping blobs whose size changes every frame
+                auto& subPath = group.subPaths[k];
+                const float cx = 60.0f * g + 30.0f * k;
+                const float cy = 50.0f;
+                const float r = 20.0f + (frame + k) % 7;
+                subPath->rewind();
+                subPath->moveTo(cx + r, cy);
+                subPath->cubicTo(cx + r, cy + r, cx - r, cy + r, cx - r, cy);
+                subPath->cubicTo(cx - r, cy - r, cx + r, cy - r, cx + r, cy);
+                subPath->close();
+            }
+            group.clip->rewind();
+            group.shape->rewind();
+            for (auto& subPath : group.subPaths) {
+                group.clip->addRenderPath(subPath.get(), rive::Mat2D());
+                group.shape->addRenderPath(subPath.get(), rive::Mat2D());
+            }
+            renderer.save();
+            renderer.clipPath(group.clip.get());
+            renderer.drawPath(group.shape.get(), fill.get());
+            renderer.drawPath(group.shape.get(), group.stroke.get());
+            renderer.restore();
+        }
+        renderer.finishRecording();
+        renderer.submit();
+    }
+}
+
+// Every thread imports every file through the same factory, then advances, tessellates and submits
+// all its artboards with its own renderer, while the others do the same
+static bool runStress(const std::vector<std::string>& files, int threadCount, int frames) {
+    AxmolFactory factory;
+    std::atomic<int> failures{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadCount; ++t) {
+        threads.emplace_back([&] {
+            NullSink sink;
+            AxmolRenderer renderer(&sink);
+            for (const auto& path : files) {
+                std::vector<uint8_t> bytes;
+                rive::ImportResult result;
+                rive::rcp<rive::File> file;
+                if (readFile(path, bytes)) {
+                    file = factory.importFile(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &result);
+                }
+                if (!file) {
+                    failures.fetch_add(1);
+                    continue;
+                }
+
+                AxmolRiveScheduler scheduler;
+                for (size_t a = 0; a < file->artboardCount(); ++a) {
+                    auto instance = scheduler.add(*file, a);
+                    if (instance) {
+                        instance->frame = rive::AABB(0.0f, 0.0f, instance->artboard->width(),
+                                                     instance->artboard->height());
+                    }
+                }
+                for (int frame = 0; frame < frames; ++frame) {
+                    scheduler.advance(1.0f / 60.0f);
+                    renderer.beginRecording();
+                    scheduler.draw(&renderer);
+                    renderer.finishRecording();
+                    renderer.submit();
+                }
+            }
+            runSharedSubPaths(factory, renderer, frames);
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    return failures.load() == 0;
+}
+
+// Equal up to rounding: within 4 ulps of 'scale', the magnitude of the largest term. Either side
+// may have been contracted into FMAs, which round once where the other rounds twice.
+static bool nearlyEqual(float a, float b, float scale) {
+    return std::abs(a - b) <= 4.0f * std::numeric_limits<float>::epsilon() * scale;
+}
+
+// Every SIMD kernel against its scalar reference: counts leaving every tail length the vector
+// loops can leave, packed and interleaved outputs, random matrices and gradients
+static bool checkKernels() {
+    static constexpr size_t Counts[] = {0, 1, 3, 5, 17, 64, 255};
+    static constexpr size_t Strides[] = {8, 12, 20}; // Vec2D, then vertices with more attributes
+    static constexpr uint8_t Canary = 0xCD;          // Bytes between strided points stay untouched
+    std::mt19937 random(20240611);
+    std::uniform_real_distribution<float> coordinate(-2000.0f, 2000.0f);
+    std::uniform_real_distribution<float> factor(-4.0f, 4.0f);
+    int failures = 0;
+    auto fail = [&failures](const char* kernel, size_t count, size_t i, float simd, float scalar) {
+        if (++failures <= 10) {
+            std::fprintf(stderr, "%s: count %zu, element %zu: %.9g, scalar %.9g\n", kernel, count, i, simd, scalar);
+        }
+    };
+
+    for (int round = 0; round < 16; ++round) {
+        const float m[6] = {factor(random), factor(random), factor(random), factor(random), coordinate(random),
+                            coordinate(random)};
+        const float sx = coordinate(random);
+        const float sy = coordinate(random);
+        const float dx = factor(random) / 1000.0f;
+        const float dy = factor(random) / 1000.0f;
+        const float invRadius = 1.0f / (std::abs(coordinate(random)) + 1.0f);
+
+        for (size_t count : Counts) {
+            std::vector<float> src(count * 2);
+            for (auto& v : src) v = coordinate(random);
+
+            for (size_t stride : Strides) {
+                std::vector<uint8_t> simd(count * stride, Canary);
+                std::vector<uint8_t> scalar(count * stride, Canary);
+                AxmolKernels::transformPoints(m, src.data(), count, simd.data(), stride);
+                AxmolKernels::transformPointsScalar(m, src.data(), count, scalar.data(), stride);
+                for (size_t i = 0; i < count; ++i) {
+                    float a[2], b[2];
+                    std::memcpy(a, simd.data() + i * stride, sizeof(a));
+                    std::memcpy(b, scalar.data() + i * stride, sizeof(b));
+                    const float x = src[i * 2];
+                    const float y = src[i * 2 + 1];
+                    const float scale[2] = {std::abs(m[0] * x) + std::abs(m[2] * y) + std::abs(m[4]),
+                                            std::abs(m[1] * x) + std::abs(m[3] * y) + std::abs(m[5])};
+                    for (int c = 0; c < 2; ++c) {
+                        if (!nearlyEqual(a[c], b[c], scale[c])) fail("transformPoints", count, i, a[c], b[c]);
+                    }
+                    for (size_t k = sizeof(a); k < stride; ++k) {
+                        if (simd[i * stride + k] != Canary) fail("transformPoints (stride)", count, i, 0.0f, 0.0f);
+                    }
+                }
+            }
+
+            std::vector<float> simd(count);
+            std::vector<float> scalar(count);
+            AxmolKernels::linearGradientT(src.data(), count, sx, sy, dx, dy, simd.data());
+            AxmolKernels::linearGradientTScalar(src.data(), count, sx, sy, dx, dy, scalar.data());
+            for (size_t i = 0; i < count; ++i) {
+                float scale = std::abs((src[i * 2] - sx) * dx) + std::abs((src[i * 2 + 1] - sy) * dy);
+                if (!nearlyEqual(simd[i], scalar[i], scale)) fail("linearGradientT", count, i, simd[i], scalar[i]);
+            }
+
+            AxmolKernels::radialGradientT(src.data(), count, sx, sy, invRadius, simd.data());
+            AxmolKernels::radialGradientTScalar(src.data(), count, sx, sy, invRadius, scalar.data());
+            for (size_t i = 0; i < count; ++i) {
+                if (!nearlyEqual(simd[i], scalar[i], std::abs(scalar[i]))) {
+                    fail("radialGradientT", count, i, simd[i], scalar[i]);
+                }
+            }
+        }
+    }
+    return failures == 0;
+}
+
+// A 50% alpha red fill over a transparent frame, saved and read back. The sink's buffer is
+// premultiplied (128, 0, 0, 128), the file must hold straight alpha (255, 0, 0, 128).
+static bool checkSave() {
+    AxmolSoftwareSink sink(4, 4);
+    sink.clear();
+    const rive::Vec2D strip[] = {{0.0f, 0.0f}, {4.0f, 0.0f}, {0.0f, 4.0f}, {4.0f, 4.0f}};
+    sink.drawStrip(rive::Span<const rive::Vec2D>(strip, 4), rive::Mat2D(), ax::Color32(255, 0, 0, 128));
+
+    const std::string path = (std::filesystem::temp_directory_path() / "rive_benchmark_check_save.png").string();
+    if (!sink.saveToFile(path)) {
+        std::fprintf(stderr, "save: can't write %s\n", path.c_str());
+        return false;
+    }
+    auto image = new ax::Image();
+    bool ok = image->initWithImageFile(path) && image->getPixelFormat() == ax::rhi::PixelFormat::RGBA8 &&
+              image->getWidth() == 4 && image->getHeight() == 4;
+    if (ok) {
+        // Loaders may premultiply again on the way in
+        const int red = image->hasPremultipliedAlpha() ? 128 : 255;
+        const uint8_t* pixel = image->getData();
+        std::printf("save: pixel %d %d %d %d, expected %d 0 0 128\n", pixel[0], pixel[1], pixel[2], pixel[3], red);
+        ok = std::abs(pixel[0] - red) <= 2 && pixel[1] == 0 && pixel[2] == 0 && std::abs(pixel[3] - 128) <= 1;
+    } else {
+        std::fprintf(stderr, "save: can't read %s back as 4x4 RGBA8\n", path.c_str());
+    }
+    image->release();
+    std::error_code ec;
+    std::filesystem::remove(path, ec);
+    return ok;
+}
+
+static bool parseOptions(int argc, char** argv, Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--frames" && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--warmup" && hasValue) {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (arg == "--raster" && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 || options.width <= 0 ||
+                options.height <= 0) {
+                return false;
+            }
+        } else if (arg == "--instances" && hasValue) {
+            options.instances = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--serial") {
+            options.serial = true;
+        } else if (arg == "--tessellate-all") {
+            options.tessellateAll = true;
+        } else if (arg == "--check-fast-paths") {
+            options.checkFastPaths = true;
+        } else if (arg == "--check-kernels") {
+            options.checkKernels = true;
+        } else if (arg == "--check-save") {
+            options.checkSave = true;
+        } else if (arg == "--stress" && hasValue) {
+            options.stressThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg.rfind("--", 0) == 0) {
+            return false;
+        } else {
+            options.inputs.push_back(arg);
+        }
+    }
+    if (options.inputs.empty()) options.inputs.push_back(RIVE_BENCHMARK_CONTENT_DIR);
+    return true;
+}
+
+int main(int argc, char** argv) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--raster WxH] [--instances N] [--serial] "
+                     "[--tessellate-all | --check-fast-paths] [--stress THREADS] [--check-kernels] "
+                     "[--check-save] [file.riv | directory ...]\n",
+                     argv[0]);
+        return 2;
+    }
+
+    if (options.checkKernels) {
+        bool ok = checkKernels();
+        std::printf("kernels: %s, %s\n", AxmolKernels::variant(), ok ? "ok" : "failed");
+        return ok ? 0 : 1;
+    }
+    if (options.checkSave) {
+        bool ok = checkSave();
+        std::printf("save: %s\n", ok ? "ok" : "failed");
+        return ok ? 0 : 1;
+    }
+
+    auto files = collectFiles(options.inputs);
+    if (files.empty()) {
+        std::fprintf(stderr, "No .riv files found\n");
+        return 1;
+    }
+    AxmolRenderPath::setFastPaths(!options.tessellateAll);
+    AxmolRenderPath::setFastPathValidation(options.checkFastPaths);
+    if (options.stressThreads > 0) {
+        bool ok = runStress(files, options.stressThreads, options.frames);
+        std::printf("stress: %d threads, %s\n", options.stressThreads, ok ? "ok" : "failed");
+        return ok ? 0 : 1;
+    }
+
+    std::unique_ptr<AxmolRenderSink> sink;
+    if (options.width > 0) {
+        sink = std::make_unique<AxmolSoftwareSink>(options.width, options.height);
+    } else {
+        sink = std::make_unique<NullSink>();
+    }
+
+    AxmolFactory factory;
+    AxmolRenderer renderer(sink.get());
+    renderer.setStatsEnabled(true);
+    renderer.setParallelTessellation(!options.serial);
+    std::printf("kernels: %s, sink: %s, tessellation: %s (%u workers), fast paths: %s\n", AxmolKernels::variant(),
+                options.width > 0 ? "software" : "null", options.serial ? "serial" : "parallel",
+                options.serial ? 0u : AxmolJobs::shared().getWorkerCount(),
+                options.tessellateAll ? "off" : (options.checkFastPaths ? "checked" : "on"));
+
+    runSharedStrokeScene(options, factory, renderer);
+
+    int failures = 0;
+    for (const auto& path : files) {
+        // Same as AxmolRiveCache: imported from a mapping of the file, from a copy without one
+        auto loadStart = std::chrono::steady_clock::now();
+        AxmolFileMapping mapping;
+        std::vector<uint8_t> bytes;
+        rive::ImportResult result;
+        rive::rcp<rive::File> file;
+        if (mapping.map(path)) {
+            file = factory.importFile(rive::Span<const uint8_t>(mapping.data(), mapping.size()), &result);
+        } else if (readFile(path, bytes)) {
+            file = factory.importFile(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &result);
+        }
+        double loadMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - loadStart).count();
+        if (!file) {
+            std::fprintf(stderr, "Failed to load %s\n", path.c_str());
+            ++failures;
+            continue;
+        }
+
+        std::printf("\n== %s\n", path.c_str());
+        std::printf("import: %.2f ms (%s)\n", loadMs, mapping.isMapped() ? "mapped" : "read");
+        for (size_t a = 0; a < file->artboardCount(); ++a) {
+            auto artboard = file->artboardAt(a);
+            int stateMachines = artboard ? static_cast<int>(artboard->stateMachineCount()) : 0;
+            if (stateMachines == 0) {
+                runScene(options, renderer, *file, a, -1);
+            }
+            for (int sm = 0; sm < stateMachines; ++sm) {
+                runScene(options, renderer, *file, a, sm);
+            }
+        }
+    }
+    if (options.checkFastPaths) {
+        uint64_t mismatches = AxmolRenderPath::getFastPathMismatchCount();
+        std::printf("\nfast paths: %llu coverage mismatches\n", static_cast<unsigned long long>(mismatches));
+        if (mismatches > 0) ++failures;
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,110 @@
+#include "AxmolFileMapping.h"
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#    define AX_RIVE_FILE_MAPPING_WIN32 1
+#elif (defined(__unix__) || defined(__APPLE__)) && !defined(__EMSCRIPTEN__)
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#    define AX_RIVE_FILE_MAPPING_POSIX 1
+#endif
+
+#if defined(AX_RIVE_FILE_MAPPING_WIN32)
+
+bool AxmolFileMapping::map(const std::string& path) {
+    unmap();
+
+    int length = MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, nullptr, 0);
+    if (length <= 0) return false;
+    std::wstring widePath(static_cast<size_t>(length), L'\0');
+    MultiByteToWideChar(CP_UTF8, 0, path.c_str(), -1, &widePath[0], length);
+
+    HANDLE file = CreateFileW(widePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0 ||
+        static_cast<unsigned long long>(size.QuadPart) > SIZE_MAX) {
+        CloseHandle(file);
+        return false;
+    }
+    HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping) {
+        CloseHandle(file);
+        return false;
+    }
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!view) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    _file = file;
+    _mapping = mapping;
+    _data = static_cast<const uint8_t*>(view);
+    _size = static_cast<size_t>(size.QuadPart);
+    return true;
+}
+
+void AxmolFileMapping::unmap() {
+    if (_data) UnmapViewOfFile(_data);
+    if (_mapping) CloseHandle(static_cast<HANDLE>(_mapping));
+    if (_file) CloseHandle(static_cast<HANDLE>(_file));
+    _data = nullptr;
+    _size = 0;
+    _mapping = nullptr;
+    _file = nullptr;
+}
+
+#elif defined(AX_RIVE_FILE_MAPPING_POSIX)
+
+bool AxmolFileMapping::map(const std::string& path) {
+    unmap();
+
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) return false;
+
+    struct stat info;
+    if (::fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size <= 0) {
+        ::close(fd);
+        return false;
+    }
+    size_t size = static_cast<size_t>(info.st_size);
+    void* view = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    // The mapping keeps its own reference to the file
+    ::close(fd);
+    if (view == MAP_FAILED) return false;
+
+    // The import reads front to back once
+    ::posix_madvise(view, size, POSIX_MADV_SEQUENTIAL);
+
+    _data = static_cast<const uint8_t*>(view);
+    _size = size;
+    return true;
+}
+
+void AxmolFileMapping::unmap() {
+    if (_data) ::munmap(const_cast<uint8_t*>(_data), _size);
+    _data = nullptr;
+    _size = 0;
+}
+
+#else
+
+bool AxmolFileMapping::map(const std::string&) {
+    return false;
+}
+
+void AxmolFileMapping::unmap() {}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef _AXMOL_FILE_MAPPING_H_
+#define _AXMOL_FILE_MAPPING_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+// Read-only memory mapping of a whole file, for importing a .riv straight from the page cache
+// instead of a heap copy of it. Pages are only read in as the import touches them, and they
+// stay clean (shared with the page cache) so they cost nothing to drop once unmapped.
+//
+// Mapping works on Windows and POSIX systems with a real file path. Everything else (Android
+// APK assets, web builds) gets false from map() and should stream the file instead.
+class AxmolFileMapping {
+public:
+    AxmolFileMapping() = default;
+    ~AxmolFileMapping() { unmap(); }
+
+    AxmolFileMapping(const AxmolFileMapping&) = delete;
+    AxmolFileMapping& operator=(const AxmolFileMapping&) = delete;
+
+    // Maps the file at 'path' (UTF-8), false when it can't be mapped or is empty
+    bool map(const std::string& path);
+    void unmap();
+
+    bool isMapped() const { return _data != nullptr; }
+    const uint8_t* data() const { return _data; }
+    size_t size() const { return _size; }
+
+private:
+    const uint8_t* _data = nullptr;
+    size_t _size = 0;
+#ifdef _WIN32
+    void* _file = nullptr;    // HANDLE
+    void* _mapping = nullptr; // HANDLE
+#endif
+};
+
+#endif // _AXMOL_FILE_MAPPING_H_
@@ -0,0 +1,73 @@
+#include "AxmolFramePipeline.h"
+#include "AxmolRive.h"
+
+AxmolFramePipeline::AxmolFramePipeline(AxmolRenderer* renderer, Producer producer)
+    : _renderer(renderer)
+    , _producer(std::move(producer)) {
+    _thread = std::thread(&AxmolFramePipeline::workerLoop, this);
+}
+
+AxmolFramePipeline::~AxmolFramePipeline() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return !_pending; });
+        _quit = true;
+    }
+    _wake.notify_all();
+    _thread.join();
+}
+
+void AxmolFramePipeline::kick(float dt) {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return !_pending; });
+        _pending = true;
+        _dt = dt;
+    }
+    _wake.notify_all();
+}
+
+void AxmolFramePipeline::sync() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return !_pending; });
+}
+
+void AxmolFramePipeline::discard() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    _idle.wait(lock, [this] { return !_pending; });
+    _recorded = false;
+}
+
+bool AxmolFramePipeline::submit() {
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _idle.wait(lock, [this] { return !_pending; });
+        if (!_recorded) return false;
+        _recorded = false;
+    }
+    // The worker is idle until the next kick, the renderer is ours
+    _renderer->submit();
+    return true;
+}
+
+void AxmolFramePipeline::workerLoop() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [this] { return _quit || _pending; });
+        if (_quit) return;
+        float dt = _dt;
+        lock.unlock();
+
+        _renderer->beginRecording();
+        bool recorded = _producer(_renderer, dt);
+        if (recorded) {
+            _renderer->finishRecording();
+        }
+
+        lock.lock();
+        // A frame nobody submitted yet stays submittable when the next one is idle
+        _recorded = _recorded || recorded;
+        _pending = false;
+        _idle.notify_all();
+    }
+}
@@ -0,0 +1,56 @@
+#ifndef _AXMOL_FRAME_PIPELINE_H_
+#define _AXMOL_FRAME_PIPELINE_H_
+
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+class AxmolRenderer;
+
+// Runs the Rive side of a frame (advance and draw-list recording) on a background thread,
+// one frame ahead of the engine. Each update the main thread takes the frame recorded during
+// the previous one, submits it and kicks the next, which then overlaps with the engine's own
+// scene render. The latency is one frame.
+//
+// While a frame is in flight the worker owns the renderer, the artboards and their state
+// machines. Anything else touching them (input, loading, removal) must call sync() first.
+class AxmolFramePipeline {
+public:
+    // Advances by dt and draws into the renderer (between beginRecording and finishRecording,
+    // done by the pipeline). Returns false when nothing changed and the frame isn't needed.
+    using Producer = std::function<bool(AxmolRenderer* renderer, float dt)>;
+
+    AxmolFramePipeline(AxmolRenderer* renderer, Producer producer);
+    ~AxmolFramePipeline();
+
+    AxmolFramePipeline(const AxmolFramePipeline&) = delete;
+    AxmolFramePipeline& operator=(const AxmolFramePipeline&) = delete;
+
+    // Starts producing the next frame. Waits for the one in flight first.
+    void kick(float dt);
+    // Waits until no frame is in flight
+    void sync();
+    // Waits for the frame in flight and drops it unsubmitted, e.g. before destroying artboards it drew
+    void discard();
+    // Waits for the frame in flight, then submits it if it was recorded. Returns true when
+    // something was submitted. Call on the thread that owns the renderer's sink.
+    bool submit();
+
+private:
+    void workerLoop();
+
+    AxmolRenderer* _renderer = nullptr;
+    Producer _producer;
+
+    std::thread _thread;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _idle;
+    bool _pending = false;  // A frame was kicked and isn't finished yet
+    bool _recorded = false; // The last finished frame was recorded and not submitted yet
+    float _dt = 0.0f;
+    bool _quit = false;
+};
+
+#endif // _AXMOL_FRAME_PIPELINE_H_
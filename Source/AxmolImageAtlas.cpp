@@ -0,0 +1,163 @@
+#include "AxmolImageAtlas.h"
+
+#include <algorithm> // For std::min, std::max
+#include <atomic>
+
+static std::atomic<bool> s_keepPixels{false};
+
+// AxmolImagePage Implementation
+AxmolImagePage::AxmolImagePage(int width, int height)
+    : _width(width)
+    , _height(height)
+    , _pixels(static_cast<size_t>(width) * height * 4, 0) {}
+
+AxmolImagePage::~AxmolImagePage() {
+    AX_SAFE_RELEASE(_texture);
+}
+
+void AxmolImagePage::setKeepPixels(bool keep) {
+    s_keepPixels.store(keep, std::memory_order_relaxed);
+}
+
+void AxmolImagePage::grow(int height) {
+    if (height <= _height) return;
+    _height = height;
+    _pixels.resize(static_cast<size_t>(_width) * _height * 4, 0);
+    _dirty = true;
+}
+
+ax::Texture2D* AxmolImagePage::texture() {
+    if (_dirty) {
+        _dirty = false;
+        AX_SAFE_RELEASE_NULL(_texture);
+        _texture = new ax::Texture2D();
+        if (!_texture->initWithData(_pixels.data(), static_cast<ssize_t>(_pixels.size()), ax::rhi::PixelFormat::RGBA8,
+                                    _width, _height, true)) {
+            AX_SAFE_RELEASE_NULL(_texture);
+        } else if (!s_keepPixels.load(std::memory_order_relaxed)) {
+            std::vector<uint8_t>().swap(_pixels);
+        }
+    }
+    return _texture;
+}
+
+// AxmolRenderImage Implementation
+AxmolRenderImage::AxmolRenderImage(rive::rcp<AxmolImagePage> page, int x, int y, int width, int height)
+    : _page(std::move(page))
+    , _x(x)
+    , _y(y) {
+    m_Width = width;
+    m_Height = height;
+}
+
+// AxmolImageAtlas Implementation
+rive::rcp<AxmolRenderImage> AxmolImageAtlas::decode(rive::Span<const uint8_t> bytes) {
+    if (bytes.empty()) return nullptr;
+
+    // Only CPU work, safe on the loader thread
+    auto image = new ax::Image();
+    rive::rcp<AxmolRenderImage> result;
+    if (image->initWithImageData(bytes.data(), static_cast<ssize_t>(bytes.size()))) {
+        result = add(image);
+    }
+    image->release();
+    return result;
+}
+
+rive::rcp<AxmolRenderImage> AxmolImageAtlas::add(ax::Image* image) {
+    int channels = 0;
+    switch (image->getPixelFormat()) {
+        case ax::rhi::PixelFormat::RGBA8: channels = 4; break;
+        case ax::rhi::PixelFormat::RGB8: channels = 3; break;
+        case ax::rhi::PixelFormat::LA8: channels = 2; break;
+        case ax::rhi::PixelFormat::L8: channels = 1; break;
+        default: break;
+    }
+    const int w = image->getWidth();
+    const int h = image->getHeight();
+    const uint8_t* src = image->getData();
+    if (channels == 0 || w <= 0 || h <= 0 || !src) {
+        AXLOGD("AxmolImageAtlas: unsupported image format");
+        return nullptr;
+    }
+
+    int x = 0;
+    int y = 0;
+    Page& page = allocate(w, h, x, y);
+    const bool premultiply = !image->hasPremultipliedAlpha();
+    const int pageWidth = page.page->width();
+    uint8_t* pixels = page.page->pixels();
+
+    // Padding rows and columns repeat the nearest edge pixel
+    for (int py = -Padding; py < h + Padding; ++py) {
+        const uint8_t* row = src + static_cast<size_t>(std::min(h - 1, std::max(0, py))) * w * channels;
+        uint8_t* out = pixels + (static_cast<size_t>(y + Padding + py) * pageWidth + x) * 4;
+        for (int px = -Padding; px < w + Padding; ++px, out += 4) {
+            const uint8_t* in = row + std::min(w - 1, std::max(0, px)) * channels;
+            uint8_t r, g, b, a = 255;
+            if (channels >= 3) {
+                r = in[0];
+                g = in[1];
+                b = in[2];
+                if (channels == 4) a = in[3];
+            } else {
+                r = g = b = in[0];
+                if (channels == 2) a = in[1];
+            }
+            if (premultiply && a != 255) {
+                r = static_cast<uint8_t>((r * a + 127) / 255);
+                g = static_cast<uint8_t>((g * a + 127) / 255);
+                b = static_cast<uint8_t>((b * a + 127) / 255);
+            }
+            out[0] = r;
+            out[1] = g;
+            out[2] = b;
+            out[3] = a;
+        }
+    }
+    page.page->markDirty();
+    return rive::make_rcp<AxmolRenderImage>(page.page, x + Padding, y + Padding, w, h);
+}
+
+AxmolImageAtlas::Page& AxmolImageAtlas::allocate(int w, int h, int& x, int& y) {
+    const int paddedW = w + Padding * 2;
+    const int paddedH = h + Padding * 2;
+    x = 0;
+    y = 0;
+
+    // Unshared or too large to share a page, it gets one of its own size (which nothing else fits in)
+    if (!_shared || paddedW > PageSize || paddedH > PageSize) {
+        Page page;
+        page.page = rive::make_rcp<AxmolImagePage>(paddedW, paddedH);
+        page.top = paddedH;
+        _pages.push_back(std::move(page));
+        return _pages.back();
+    }
+
+    for (auto& page : _pages) {
+        if (page.page->width() != PageSize) continue;
+        // Shelves no more than twice as tall as the image, so small images don't waste tall rows
+        for (auto& shelf : page.shelves) {
+            if (shelf.height >= paddedH && shelf.height <= paddedH * 2 && shelf.x + paddedW <= PageSize) {
+                x = shelf.x;
+                y = shelf.y;
+                shelf.x += paddedW;
+                return page;
+            }
+        }
+        if (page.top + paddedH <= PageSize) {
+            page.shelves.push_back({page.top, paddedH, paddedW});
+            y = page.top;
+            page.top += paddedH;
+            page.page->grow(page.top);
+            return page;
+        }
+    }
+
+    Page page;
+    page.page = rive::make_rcp<AxmolImagePage>(PageSize, paddedH);
+    page.shelves.push_back({0, paddedH, paddedW});
+    page.top = paddedH;
+    _pages.push_back(std::move(page));
+    return _pages.back();
+}
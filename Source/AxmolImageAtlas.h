@@ -0,0 +1,112 @@
+#ifndef _AXMOL_IMAGE_ATLAS_H_
+#define _AXMOL_IMAGE_ATLAS_H_
+
+#include "axmol/axmol.h"
+
+#include "rive/renderer.hpp"
+#include "rive/refcnt.hpp"
+#include "rive/span.hpp"
+
+#include <vector>
+
+// One texture of an AxmolImageAtlas. The pixels are premultiplied RGBA8, rows from top to bottom.
+// Software sinks sample them directly; once uploaded they are freed (unless setKeepPixels), so
+// images drawn on the GPU don't cost their memory twice.
+class AxmolImagePage : public rive::RefCnt<AxmolImagePage> {
+public:
+    AxmolImagePage(int width, int height);
+    ~AxmolImagePage();
+
+    // Process-wide, off by default. Keeps the CPU copy after the upload, for apps rendering the
+    // same files with AxmolSoftwareSink and on the GPU. Set before drawing.
+    static void setKeepPixels(bool keep);
+
+    // Adds rows at the bottom while the atlas packs, existing pixels keep their place.
+    // Packing is over before the first upload.
+    void grow(int height);
+
+    int width() const { return _width; }
+    int height() const { return _height; }
+    // False once freed by the upload
+    bool hasPixels() const { return !_pixels.empty(); }
+    const uint8_t* pixels() const { return _pixels.data(); }
+    uint8_t* pixels() { return _pixels.data(); }
+
+    // Uploaded on first use after the pixels changed, call on the Axmol thread
+    ax::Texture2D* texture();
+    void markDirty() { _dirty = true; }
+
+private:
+    int _width = 0;
+    int _height = 0;
+    std::vector<uint8_t> _pixels;
+    ax::Texture2D* _texture = nullptr;
+    bool _dirty = true;
+};
+
+// Image of a .riv placed in an atlas page at (x, y)
+class AxmolRenderImage : public rive::RenderImage {
+public:
+    AxmolRenderImage(rive::rcp<AxmolImagePage> page, int x, int y, int width, int height);
+
+    AxmolImagePage* page() const { return _page.get(); }
+    // The image's own 0..1 uv to page uv. Computed when drawn: pages only get their final
+    // height once the whole file is packed.
+    rive::Vec2D pageUV(rive::Vec2D uv) const {
+        return {(_x + uv.x * m_Width) / _page->width(), (_y + uv.y * m_Height) / _page->height()};
+    }
+    // Same mapping for shaders, page uv = uv * (out[0], out[1]) + (out[2], out[3])
+    void uvTransform(float out[4]) const {
+        out[0] = static_cast<float>(m_Width) / _page->width();
+        out[1] = static_cast<float>(m_Height) / _page->height();
+        out[2] = static_cast<float>(_x) / _page->width();
+        out[3] = static_cast<float>(_y) / _page->height();
+    }
+
+private:
+    rive::rcp<AxmolImagePage> _page;
+    int _x = 0;
+    int _y = 0;
+};
+
+// Packs the images of one file into shared pages on shelves, so the draws of all its images
+// can use the same texture. Pages are PageSize wide and only as tall as their shelves.
+// Used by one thread at a time, typically the one importing the file; the pages outlive it
+// through their images.
+//
+// Samplers can't wrap inside an atlas, images are always clamped to their edges.
+class AxmolImageAtlas {
+public:
+    static constexpr int PageSize = 2048;
+    // Edge pixels repeated around each image, so filtering never reads a neighbour
+    static constexpr int Padding = 1;
+
+    // Unshared, every image gets a page of its own padded size (for single decodes, where a
+    // PageSize wide page would mostly stay empty)
+    explicit AxmolImageAtlas(bool shared = true) : _shared(shared) {}
+
+    // Decodes an encoded image (PNG, JPEG, WebP, ...) into a page, null when it can't be decoded
+    rive::rcp<AxmolRenderImage> decode(rive::Span<const uint8_t> bytes);
+    // Copies an already decoded image into a page, null for formats other than (L|LA|RGB|RGBA)8
+    rive::rcp<AxmolRenderImage> add(ax::Image* image);
+
+private:
+    struct Shelf {
+        int y = 0;
+        int height = 0;
+        int x = 0; // Where the next image goes
+    };
+    struct Page {
+        rive::rcp<AxmolImagePage> page;
+        std::vector<Shelf> shelves;
+        int top = 0; // Where the next shelf goes
+    };
+
+    // Finds room for a padded w x h rect, opening a shelf or a page when needed
+    Page& allocate(int w, int h, int& x, int& y);
+
+    std::vector<Page> _pages;
+    bool _shared = true;
+};
+
+#endif // _AXMOL_IMAGE_ATLAS_H_
@@ -0,0 +1,90 @@
+#include "AxmolJobs.h"
+
+#include <algorithm> // For std::min, std::max
+
+AxmolJobs& AxmolJobs::shared() {
+    // Capped, the work handed out per frame rarely keeps more threads busy
+    static AxmolJobs s_jobs(std::min(7u, std::max(1u, std::thread::hardware_concurrency()) - 1));
+    return s_jobs;
+}
+
+AxmolJobs::AxmolJobs(unsigned workerCount) {
+    _threads.reserve(workerCount);
+    for (unsigned i = 0; i < workerCount; ++i) {
+        _threads.emplace_back(&AxmolJobs::workerLoop, this);
+    }
+}
+
+AxmolJobs::~AxmolJobs() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _quit = true;
+    }
+    _wake.notify_all();
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+void AxmolJobs::parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& fn) {
+    if (count == 0) return;
+    chunk = std::max<size_t>(1, chunk);
+
+    // Not worth waking anyone for a single chunk, and nested ranges can't share the counter
+    if (_threads.empty() || count <= chunk || _busy.exchange(true, std::memory_order_acquire)) {
+        fn(0, count);
+        return;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        // A worker that woke late for the previous range may still hold its parameters
+        _done.wait(lock, [this] { return _active == 0; });
+        _fn = &fn;
+        _count = count;
+        _chunk = chunk;
+        _next.store(0, std::memory_order_relaxed);
+        ++_generation;
+    }
+    _wake.notify_all();
+
+    runChunks(&fn, count, chunk);
+
+    {
+        // Every chunk is taken, wait for the ones still running on workers
+        std::unique_lock<std::mutex> lock(_mutex);
+        _done.wait(lock, [this] { return _active == 0; });
+        _fn = nullptr;
+    }
+    _busy.store(false, std::memory_order_release);
+}
+
+void AxmolJobs::runChunks(const std::function<void(size_t, size_t)>* fn, size_t count, size_t chunk) {
+    while (true) {
+        size_t begin = _next.fetch_add(chunk, std::memory_order_relaxed);
+        if (begin >= count) return;
+        (*fn)(begin, std::min(count, begin + chunk));
+    }
+}
+
+void AxmolJobs::workerLoop() {
+    uint64_t seen = 0;
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (true) {
+        _wake.wait(lock, [&] { return _quit || _generation != seen; });
+        if (_quit) return;
+
+        // Parameters are read under the lock together with the generation they belong to
+        seen = _generation;
+        auto fn = _fn;
+        size_t count = _count;
+        size_t chunk = _chunk;
+        ++_active;
+        lock.unlock();
+
+        if (fn) runChunks(fn, count, chunk);
+
+        lock.lock();
+        if (--_active == 0) _done.notify_all();
+    }
+}
@@ -0,0 +1,54 @@
+#ifndef _AXMOL_JOBS_H_
+#define _AXMOL_JOBS_H_
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Fixed pool of worker threads for fork-join work. parallelFor hands out chunks of an index
+// range from a shared counter; the calling thread takes chunks too and returns once all ran.
+// One range runs at a time, a parallelFor issued while another is running (from a job or
+// from a second thread) simply runs inline on its caller.
+class AxmolJobs {
+public:
+    // Pool shared by the renderer, one worker per core besides the calling thread
+    static AxmolJobs& shared();
+
+    explicit AxmolJobs(unsigned workerCount);
+    ~AxmolJobs();
+
+    AxmolJobs(const AxmolJobs&) = delete;
+    AxmolJobs& operator=(const AxmolJobs&) = delete;
+
+    unsigned getWorkerCount() const { return static_cast<unsigned>(_threads.size()); }
+
+    // Calls fn(begin, end) on chunks of at most 'chunk' indices covering [0, count).
+    // Chunks run in no particular order and on any thread.
+    void parallelFor(size_t count, size_t chunk, const std::function<void(size_t, size_t)>& fn);
+
+private:
+    void workerLoop();
+    void runChunks(const std::function<void(size_t, size_t)>* fn, size_t count, size_t chunk);
+
+    std::vector<std::thread> _threads;
+    std::mutex _mutex;
+    std::condition_variable _wake;
+    std::condition_variable _done;
+    std::atomic<bool> _busy{false};
+
+    // Current range, written under _mutex before _generation moves on
+    const std::function<void(size_t, size_t)>* _fn = nullptr;
+    size_t _count = 0;
+    size_t _chunk = 1;
+    std::atomic<size_t> _next{0};
+    uint64_t _generation = 0;
+    unsigned _active = 0; // Workers inside the current range
+    bool _quit = false;
+};
+
+#endif // _AXMOL_JOBS_H_
@@ -0,0 +1,191 @@
+#include "AxmolKernels.h"
+
+#include <cmath>
+#include <cstring>
+
+#if defined(AXMOL_KERNELS_SSE2)
+#    include <emmintrin.h>
+#elif defined(AXMOL_KERNELS_NEON)
+#    include <arm_neon.h>
+#endif
+
+// The SIMD variants keep the scalar operation order and use no fused multiply-add, but the
+// compiler may still contract the scalar code (the tails, and the reference) into FMAs, on
+// AArch64 in particular. Results match the reference within a few ulps of the largest term,
+// not bit for bit: rive_benchmark --check-kernels compares them with that tolerance.
+
+namespace AxmolKernels {
+
+const char* variant() {
+#if defined(AXMOL_KERNELS_SSE2)
+    return "sse2";
+#elif defined(AXMOL_KERNELS_NEON)
+    return "neon";
+#else
+    return "scalar";
+#endif
+}
+
+// Scalar reference
+
+static inline void storePoint(void* dst, float x, float y) {
+    float xy[2] = {x, y};
+    std::memcpy(dst, xy, sizeof(xy));
+}
+
+void transformPointsScalar(const float m[6], const float* src, size_t count, void* dst, size_t dstStride) {
+    auto out = static_cast<char*>(dst);
+    for (size_t i = 0; i < count; ++i) {
+        float x = src[i * 2];
+        float y = src[i * 2 + 1];
+        storePoint(out + i * dstStride, m[0] * x + m[2] * y + m[4], m[1] * x + m[3] * y + m[5]);
+    }
+}
+
+void linearGradientTScalar(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t) {
+    for (size_t i = 0; i < count; ++i) {
+        t[i] = (src[i * 2] - sx) * dx + (src[i * 2 + 1] - sy) * dy;
+    }
+}
+
+void radialGradientTScalar(const float* src, size_t count, float cx, float cy, float invRadius, float* t) {
+    for (size_t i = 0; i < count; ++i) {
+        float dx = src[i * 2] - cx;
+        float dy = src[i * 2 + 1] - cy;
+        t[i] = std::sqrt(dx * dx + dy * dy) * invRadius;
+    }
+}
+
+#if defined(AXMOL_KERNELS_SSE2)
+
+void transformPoints(const float m[6], const float* src, size_t count, void* dst, size_t dstStride) {
+    const __m128 a = _mm_setr_ps(m[0], m[1], m[0], m[1]);
+    const __m128 b = _mm_setr_ps(m[2], m[3], m[2], m[3]);
+    const __m128 tr = _mm_setr_ps(m[4], m[5], m[4], m[5]);
+    auto out = static_cast<char*>(dst);
+
+    size_t i = 0;
+    for (; i + 2 <= count; i += 2) {
+        __m128 p = _mm_loadu_ps(src + i * 2); // x0 y0 x1 y1
+        __m128 xs = _mm_shuffle_ps(p, p, _MM_SHUFFLE(2, 2, 0, 0));
+        __m128 ys = _mm_shuffle_ps(p, p, _MM_SHUFFLE(3, 3, 1, 1));
+        __m128 r = _mm_add_ps(_mm_add_ps(_mm_mul_ps(xs, a), _mm_mul_ps(ys, b)), tr);
+
+        char* d = out + i * dstStride;
+        if (dstStride == sizeof(float) * 2) {
+            _mm_storeu_ps(reinterpret_cast<float*>(d), r);
+        } else {
+            _mm_storel_pi(reinterpret_cast<__m64*>(d), r);
+            _mm_storeh_pi(reinterpret_cast<__m64*>(d + dstStride), r);
+        }
+    }
+    transformPointsScalar(m, src + i * 2, count - i, out + i * dstStride, dstStride);
+}
+
+void linearGradientT(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t) {
+    const __m128 vsx = _mm_set1_ps(sx);
+    const __m128 vsy = _mm_set1_ps(sy);
+    const __m128 vdx = _mm_set1_ps(dx);
+    const __m128 vdy = _mm_set1_ps(dy);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 p0 = _mm_loadu_ps(src + i * 2);
+        __m128 p1 = _mm_loadu_ps(src + i * 2 + 4);
+        __m128 xs = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0));
+        __m128 ys = _mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1));
+        __m128 r = _mm_add_ps(_mm_mul_ps(_mm_sub_ps(xs, vsx), vdx), _mm_mul_ps(_mm_sub_ps(ys, vsy), vdy));
+        _mm_storeu_ps(t + i, r);
+    }
+    linearGradientTScalar(src + i * 2, count - i, sx, sy, dx, dy, t + i);
+}
+
+void radialGradientT(const float* src, size_t count, float cx, float cy, float invRadius, float* t) {
+    const __m128 vcx = _mm_set1_ps(cx);
+    const __m128 vcy = _mm_set1_ps(cy);
+    const __m128 vinv = _mm_set1_ps(invRadius);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 p0 = _mm_loadu_ps(src + i * 2);
+        __m128 p1 = _mm_loadu_ps(src + i * 2 + 4);
+        __m128 dx = _mm_sub_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(2, 0, 2, 0)), vcx);
+        __m128 dy = _mm_sub_ps(_mm_shuffle_ps(p0, p1, _MM_SHUFFLE(3, 1, 3, 1)), vcy);
+        __m128 distSq = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+        _mm_storeu_ps(t + i, _mm_mul_ps(_mm_sqrt_ps(distSq), vinv));
+    }
+    radialGradientTScalar(src + i * 2, count - i, cx, cy, invRadius, t + i);
+}
+
+#elif defined(AXMOL_KERNELS_NEON)
+
+void transformPoints(const float m[6], const float* src, size_t count, void* dst, size_t dstStride) {
+    auto out = static_cast<char*>(dst);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t p = vld2q_f32(src + i * 2); // Deinterleaved xs, ys
+        float32x4x2_t r;
+        r.val[0] = vaddq_f32(vaddq_f32(vmulq_n_f32(p.val[0], m[0]), vmulq_n_f32(p.val[1], m[2])), vdupq_n_f32(m[4]));
+        r.val[1] = vaddq_f32(vaddq_f32(vmulq_n_f32(p.val[0], m[1]), vmulq_n_f32(p.val[1], m[3])), vdupq_n_f32(m[5]));
+
+        char* d = out + i * dstStride;
+        if (dstStride == sizeof(float) * 2) {
+            vst2q_f32(reinterpret_cast<float*>(d), r);
+        } else {
+            float xs[4], ys[4];
+            vst1q_f32(xs, r.val[0]);
+            vst1q_f32(ys, r.val[1]);
+            for (int k = 0; k < 4; ++k) {
+                storePoint(d + k * dstStride, xs[k], ys[k]);
+            }
+        }
+    }
+    transformPointsScalar(m, src + i * 2, count - i, out + i * dstStride, dstStride);
+}
+
+void linearGradientT(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t) {
+    const float32x4_t vsx = vdupq_n_f32(sx);
+    const float32x4_t vsy = vdupq_n_f32(sy);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t p = vld2q_f32(src + i * 2);
+        float32x4_t r = vaddq_f32(vmulq_n_f32(vsubq_f32(p.val[0], vsx), dx), vmulq_n_f32(vsubq_f32(p.val[1], vsy), dy));
+        vst1q_f32(t + i, r);
+    }
+    linearGradientTScalar(src + i * 2, count - i, sx, sy, dx, dy, t + i);
+}
+
+void radialGradientT(const float* src, size_t count, float cx, float cy, float invRadius, float* t) {
+    const float32x4_t vcx = vdupq_n_f32(cx);
+    const float32x4_t vcy = vdupq_n_f32(cy);
+
+    size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        float32x4x2_t p = vld2q_f32(src + i * 2);
+        float32x4_t dx = vsubq_f32(p.val[0], vcx);
+        float32x4_t dy = vsubq_f32(p.val[1], vcy);
+        float32x4_t distSq = vaddq_f32(vmulq_f32(dx, dx), vmulq_f32(dy, dy));
+        vst1q_f32(t + i, vmulq_n_f32(vsqrtq_f32(distSq), invRadius));
+    }
+    radialGradientTScalar(src + i * 2, count - i, cx, cy, invRadius, t + i);
+}
+
+#else
+
+void transformPoints(const float m[6], const float* src, size_t count, void* dst, size_t dstStride) {
+    transformPointsScalar(m, src, count, dst, dstStride);
+}
+
+void linearGradientT(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t) {
+    linearGradientTScalar(src, count, sx, sy, dx, dy, t);
+}
+
+void radialGradientT(const float* src, size_t count, float cx, float cy, float invRadius, float* t) {
+    radialGradientTScalar(src, count, cx, cy, invRadius, t);
+}
+
+#endif
+
+} // namespace AxmolKernels
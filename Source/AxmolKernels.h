@@ -0,0 +1,43 @@
+#ifndef _AXMOL_KERNELS_H_
+#define _AXMOL_KERNELS_H_
+
+#include <cstddef>
+
+// Batch kernels for the CPU side of the renderer. The SIMD variant (SSE2 or AArch64 NEON)
+// is picked at compile time, the scalar one is always built and is the reference (equal up
+// to rounding, see AxmolKernels.cpp).
+// Points are tightly packed x, y float pairs (rive::Vec2D layout).
+//
+// Used by AxmolSoftwareSink (vertices to screen) and AxmolRenderShader::getColors (gradients
+// evaluated per vertex). GPU draws and clips keep their vertices local and transform them in
+// rive_path.vert, so AxmolRenderer's drawPath/clipPath have no per-vertex CPU loop to run here.
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    define AXMOL_KERNELS_SSE2 1
+#elif (defined(__ARM_NEON) || defined(__ARM_NEON__)) && (defined(__aarch64__) || defined(_M_ARM64))
+#    define AXMOL_KERNELS_NEON 1
+#endif
+
+namespace AxmolKernels {
+
+// Name of the variant compiled in: "sse2", "neon" or "scalar"
+const char* variant();
+
+// dst[i] = m * src[i], m is a rive::Mat2D (xx, xy, yx, yy, tx, ty).
+// Each result is written as two floats at dst + i * dstStride bytes, so it can land
+// straight in an interleaved vertex buffer.
+void transformPoints(const float m[6], const float* src, size_t count, void* dst, size_t dstStride);
+void transformPointsScalar(const float m[6], const float* src, size_t count, void* dst, size_t dstStride);
+
+// Linear gradient parameter: t[i] = dot(src[i] - start, dir), dir is (end - start) / |end - start|^2.
+// Not clamped.
+void linearGradientT(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t);
+void linearGradientTScalar(const float* src, size_t count, float sx, float sy, float dx, float dy, float* t);
+
+// Radial gradient parameter: t[i] = |src[i] - center| * invRadius. Not clamped.
+void radialGradientT(const float* src, size_t count, float cx, float cy, float invRadius, float* t);
+void radialGradientTScalar(const float* src, size_t count, float cx, float cy, float invRadius, float* t);
+
+} // namespace AxmolKernels
+
+#endif // _AXMOL_KERNELS_H_
@@ -0,0 +1,801 @@
+#include "AxmolMeshNode.h"
+#include "AxmolRive.h"
+
+#include <algorithm> // For std::max, std::copy
+#include <atomic>
+#include <cstddef> // For offsetof
+#include <cstring> // For std::memcmp
+
+// Position is 2D, color is 4 normalized bytes, slot a float. Matches AxmolMeshVertex.
+static void setupVertexLayout(ax::rhi::ProgramState* programState) {
+    auto vertexLayout = programState->getMutableVertexLayout();
+    vertexLayout->setAttrib("a_position", programState->getAttributeLocation("a_position"),
+                            ax::rhi::VertexFormat::FLOAT2, 0, false);
+    vertexLayout->setAttrib("a_color", programState->getAttributeLocation("a_color"),
+                            ax::rhi::VertexFormat::UBYTE4, offsetof(AxmolMeshVertex, color), true);
+    vertexLayout->setAttrib("a_slot", programState->getAttributeLocation("a_slot"),
+                            ax::rhi::VertexFormat::FLOAT, offsetof(AxmolMeshVertex, slot), false);
+    vertexLayout->setStride(sizeof(AxmolMeshVertex));
+}
+
+// Position and uv, both 2D floats, slot a float. Matches AxmolImageVertex.
+static void setupImageVertexLayout(ax::rhi::ProgramState* programState) {
+    auto vertexLayout = programState->getMutableVertexLayout();
+    vertexLayout->setAttrib("a_position", programState->getAttributeLocation("a_position"),
+                            ax::rhi::VertexFormat::FLOAT2, 0, false);
+    vertexLayout->setAttrib("a_texCoord", programState->getAttributeLocation("a_texCoord"),
+                            ax::rhi::VertexFormat::FLOAT2, offsetof(AxmolImageVertex, texCoord), false);
+    vertexLayout->setAttrib("a_slot", programState->getAttributeLocation("a_slot"),
+                            ax::rhi::VertexFormat::FLOAT, offsetof(AxmolImageVertex, slot), false);
+    vertexLayout->setStride(sizeof(AxmolImageVertex));
+}
+
+// Position only, 2D floats. Matches the quad of rive_blit.
+static void setupBlitVertexLayout(ax::rhi::ProgramState* programState) {
+    auto vertexLayout = programState->getMutableVertexLayout();
+    vertexLayout->setAttrib("a_position", programState->getAttributeLocation("a_position"),
+                            ax::rhi::VertexFormat::FLOAT2, 0, false);
+    vertexLayout->setStride(sizeof(float) * 2);
+}
+
+// Sets the renderer's stencil state, runs in command order from a CallbackCommand
+static void applyStencil(ax::Renderer* renderer, AxmolStencilState stencil) {
+    using Op = AxmolStencilState::Op;
+    if (stencil.op == Op::none) {
+        renderer->setStencilTest(false);
+        return;
+    }
+
+    ax::rhi::StencilOperation pass = ax::rhi::StencilOperation::KEEP;
+    if (stencil.op == Op::increment) pass = ax::rhi::StencilOperation::INCREMENT_WRAP;
+    if (stencil.op == Op::decrement) pass = ax::rhi::StencilOperation::DECREMENT_WRAP;
+
+    renderer->setStencilTest(true);
+    renderer->setStencilCompareFunction(ax::rhi::CompareFunction::EQUAL, stencil.ref, 0xFF);
+    renderer->setStencilOperation(ax::rhi::StencilOperation::KEEP, ax::rhi::StencilOperation::KEEP, pass);
+    renderer->setStencilWriteMask(stencil.op == Op::test ? 0x00 : 0xFF);
+}
+
+// Blend factors of 'state' for a premultiplied source. Alpha composites over, except for the
+// blend shaders which write the final pixel.
+static void setBlendFactors(ax::rhi::BlendDescriptor& blend, AxmolBlendState state) {
+    using Factor = ax::rhi::BlendFactor;
+    blend.blendEnabled = true;
+    blend.sourceAlphaBlendFactor = Factor::ONE;
+    blend.destinationAlphaBlendFactor = Factor::ONE_MINUS_SRC_ALPHA;
+    switch (state) {
+        case AxmolBlendState::srcOver:
+            blend.sourceRGBBlendFactor = Factor::ONE;
+            blend.destinationRGBBlendFactor = Factor::ONE_MINUS_SRC_ALPHA;
+            break;
+        case AxmolBlendState::screen:
+            // s + d - s * d
+            blend.sourceRGBBlendFactor = Factor::ONE;
+            blend.destinationRGBBlendFactor = Factor::ONE_MINUS_SRC_COLOR;
+            break;
+        case AxmolBlendState::exclusion:
+            // s + d - 2 * s * d
+            blend.sourceRGBBlendFactor = Factor::ONE_MINUS_DST_COLOR;
+            blend.destinationRGBBlendFactor = Factor::ONE_MINUS_SRC_COLOR;
+            break;
+        case AxmolBlendState::advanced:
+            blend.sourceRGBBlendFactor = Factor::ONE;
+            blend.destinationRGBBlendFactor = Factor::ZERO;
+            blend.destinationAlphaBlendFactor = Factor::ZERO;
+            break;
+    }
+}
+
+static ax::rhi::Buffer* newBuffer(size_t size, ax::rhi::BufferType type, ax::rhi::BufferUsage usage) {
+    return ax::rhi::DriverBase::getInstance()->newBuffer(size, type, usage);
+}
+
+// AxmolMeshNode Implementation
+AxmolMeshNode::DrawCall::~DrawCall() {
+    AX_SAFE_RELEASE(programState);
+    AX_SAFE_RELEASE(imageProgramState);
+    AX_SAFE_RELEASE(blendProgramState);
+    AX_SAFE_RELEASE(imageBlendProgramState);
+    AX_SAFE_RELEASE(mesh);
+}
+
+bool AxmolMeshNode::PathProgram::load(const char* fragmentShader) {
+    program = ax::ProgramManager::getInstance()->loadProgram("custom/rive_path_vs", fragmentShader);
+    if (!program) return false;
+
+    mvp = program->getUniformLocation("u_MVPMatrix");
+    affine = program->getUniformLocation("u_riveAffine");
+    translate = program->getUniformLocation("u_riveTranslate");
+    color = program->getUniformLocation("u_color");
+    gradientType = program->getUniformLocation("u_gradientType");
+    gradientPoints = program->getUniformLocation("u_gradientPoints");
+    stopOffsets = program->getUniformLocation("u_stopOffsets");
+    stopColors = program->getUniformLocation("u_stopColors");
+    blendMode = program->getUniformLocation("u_blendMode");
+    backdrop = program->getUniformLocation("u_backdrop");
+    return true;
+}
+
+bool AxmolMeshNode::ImageProgram::load(const char* fragmentShader) {
+    program = ax::ProgramManager::getInstance()->loadProgram("custom/rive_image_vs", fragmentShader);
+    if (!program) return false;
+
+    mvp = program->getUniformLocation("u_MVPMatrix");
+    affine = program->getUniformLocation("u_riveAffine");
+    translate = program->getUniformLocation("u_riveTranslate");
+    uvTransform = program->getUniformLocation("u_uvTransform");
+    color = program->getUniformLocation("u_color");
+    texture = program->getUniformLocation("u_tex0");
+    blendMode = program->getUniformLocation("u_blendMode");
+    backdrop = program->getUniformLocation("u_backdrop");
+    return true;
+}
+
+AxmolMeshNode* AxmolMeshNode::create() {
+    auto node = new AxmolMeshNode();
+    if (node->init()) {
+        node->autorelease();
+        return node;
+    }
+    AX_SAFE_DELETE(node);
+    return nullptr;
+}
+
+AxmolMeshNode::~AxmolMeshNode() {
+    for (auto& clip : _clips) {
+        AX_SAFE_RELEASE(clip.mesh);
+    }
+    _drawCalls.clear();
+    AX_SAFE_RELEASE(_vertexBuffer);
+    AX_SAFE_RELEASE(_indexBuffer);
+    AX_SAFE_RELEASE(_imageVertexBuffer);
+    releaseLayer();
+    AX_SAFE_RELEASE(_copyProgramState);
+    AX_SAFE_RELEASE(_compositeProgramState);
+    AX_SAFE_RELEASE(_quadVertexBuffer);
+    AX_SAFE_RELEASE(_quadIndexBuffer);
+}
+
+bool AxmolMeshNode::init() {
+    if (!ax::Node::init()) return false;
+
+    if (!_pathProgram.load("custom/rive_path_fs")) return false;
+    _imageProgram.load("custom/rive_image_fs");
+
+    // Advanced blend modes need both blend programs and the layer copies
+    _blitProgram = ax::ProgramManager::getInstance()->loadProgram("custom/rive_blit_vs", "custom/rive_blit_fs");
+    if (_blitProgram && _pathBlendProgram.load("custom/rive_path_blend_fs") &&
+        (!_imageProgram.program || _imageBlendProgram.load("custom/rive_image_blend_fs"))) {
+        _blitTextureLocation = _blitProgram->getUniformLocation("u_tex0");
+        _copyProgramState = new ax::rhi::ProgramState(_blitProgram);
+        setupBlitVertexLayout(_copyProgramState);
+        _compositeProgramState = new ax::rhi::ProgramState(_blitProgram);
+        setupBlitVertexLayout(_compositeProgramState);
+
+        const float quad[] = {-1.0f, -1.0f, 1.0f, -1.0f, -1.0f, 1.0f, 1.0f, 1.0f};
+        const uint16_t quadIndices[] = {0, 1, 2, 2, 1, 3};
+        _quadVertexBuffer = newBuffer(sizeof(quad), ax::rhi::BufferType::VERTEX, ax::rhi::BufferUsage::STATIC);
+        _quadVertexBuffer->updateData(quad, sizeof(quad));
+        _quadIndexBuffer = newBuffer(sizeof(quadIndices), ax::rhi::BufferType::INDEX, ax::rhi::BufferUsage::STATIC);
+        _quadIndexBuffer->updateData(quadIndices, sizeof(quadIndices));
+
+        _compositeCommand.setDrawType(ax::CustomCommand::DrawType::ELEMENT);
+        _compositeCommand.setPrimitiveType(ax::CustomCommand::PrimitiveType::TRIANGLE);
+        _compositeCommand.getPipelineDescriptor().programState = _compositeProgramState;
+        setBlendFactors(_compositeCommand.getPipelineDescriptor().blendDescriptor, AxmolBlendState::srcOver);
+    } else {
+        _pathBlendProgram.program = nullptr;
+        _imageBlendProgram.program = nullptr;
+    }
+    return true;
+}
+
+void AxmolMeshNode::clear() {
+    for (size_t i = 0; i < _drawCallCount; ++i) {
+        AX_SAFE_RELEASE_NULL(_drawCalls[i]->mesh);
+        _drawCalls[i]->image = nullptr;
+    }
+    _drawCallCount = 0;
+    for (auto& clip : _clips) {
+        AX_SAFE_RELEASE(clip.mesh);
+    }
+    _clips.clear();
+    _vertices.clear();
+    _indices.clear();
+    _imageVertices.clear();
+    _blend = AxmolBlendState::srcOver;
+    _blendMode = 0;
+    _dirty = true;
+}
+
+bool AxmolMeshNode::blendStateFor(rive::BlendMode mode, AxmolBlendState& state) {
+    switch (mode) {
+        case rive::BlendMode::srcOver:
+            state = AxmolBlendState::srcOver;
+            return true;
+        case rive::BlendMode::screen:
+            state = AxmolBlendState::screen;
+            return true;
+        case rive::BlendMode::exclusion:
+            state = AxmolBlendState::exclusion;
+            return true;
+        default:
+            return false;
+    }
+}
+
+int AxmolMeshNode::blendShaderMode(rive::BlendMode mode) {
+    // Must match blendColor of rive_path_blend.frag and rive_image_blend.frag
+    switch (mode) {
+        case rive::BlendMode::multiply: return 1;
+        case rive::BlendMode::overlay: return 2;
+        case rive::BlendMode::darken: return 3;
+        case rive::BlendMode::lighten: return 4;
+        case rive::BlendMode::colorDodge: return 5;
+        case rive::BlendMode::colorBurn: return 6;
+        case rive::BlendMode::hardLight: return 7;
+        case rive::BlendMode::softLight: return 8;
+        case rive::BlendMode::difference: return 9;
+        case rive::BlendMode::hue: return 10;
+        case rive::BlendMode::saturation: return 11;
+        case rive::BlendMode::color: return 12;
+        case rive::BlendMode::luminosity: return 13;
+        default: return 0;
+    }
+}
+
+static const char* blendModeName(rive::BlendMode mode) {
+    switch (mode) {
+        case rive::BlendMode::multiply: return "multiply";
+        case rive::BlendMode::overlay: return "overlay";
+        case rive::BlendMode::darken: return "darken";
+        case rive::BlendMode::lighten: return "lighten";
+        case rive::BlendMode::colorDodge: return "colorDodge";
+        case rive::BlendMode::colorBurn: return "colorBurn";
+        case rive::BlendMode::hardLight: return "hardLight";
+        case rive::BlendMode::softLight: return "softLight";
+        case rive::BlendMode::difference: return "difference";
+        case rive::BlendMode::hue: return "hue";
+        case rive::BlendMode::saturation: return "saturation";
+        case rive::BlendMode::color: return "color";
+        case rive::BlendMode::luminosity: return "luminosity";
+        default: return "unknown";
+    }
+}
+
+void AxmolMeshNode::setBlendMode(rive::BlendMode mode) {
+    _blendMode = 0;
+    if (blendStateFor(mode, _blend)) return;
+
+    _blendMode = blendShaderMode(mode);
+    if (_blendMode > 0 && _pathBlendProgram.program) {
+        _blend = AxmolBlendState::advanced;
+        return;
+    }
+
+    // Drawn as srcOver rather than as some other operator, reported once per mode for the process
+    static std::atomic<uint32_t> s_reported{0};
+    _blend = AxmolBlendState::srcOver;
+    _blendMode = 0;
+    const uint32_t bit = 1u << (static_cast<uint32_t>(mode) & 31);
+    if (!(s_reported.fetch_or(bit, std::memory_order_relaxed) & bit)) {
+        AXLOGD("AxmolMeshNode: blend mode %s (%d) has no blend program, drawn as srcOver",
+               blendModeName(mode), static_cast<int>(mode));
+    }
+}
+
+ax::rhi::ProgramState* AxmolMeshNode::programStateFor(DrawCall* call, bool image, bool advanced) {
+    ax::rhi::ProgramState** state = image ? (advanced ? &call->imageBlendProgramState : &call->imageProgramState)
+                                          : (advanced ? &call->blendProgramState : &call->programState);
+    if (!*state) {
+        if (image) {
+            *state = new ax::rhi::ProgramState(advanced ? _imageBlendProgram.program : _imageProgram.program);
+            setupImageVertexLayout(*state);
+        } else {
+            *state = new ax::rhi::ProgramState(advanced ? _pathBlendProgram.program : _pathProgram.program);
+            setupVertexLayout(*state);
+        }
+    }
+    return *state;
+}
+
+void AxmolMeshNode::setCallBlend(DrawCall* call, AxmolBlendState blend, int blendMode) {
+    call->blend = blend;
+    call->blendMode = blendMode;
+    call->command.getPipelineDescriptor().programState =
+        programStateFor(call, call->image != nullptr, blend == AxmolBlendState::advanced);
+    setBlendFactors(call->command.getPipelineDescriptor().blendDescriptor, blend);
+}
+
+AxmolMeshNode::DrawCall* AxmolMeshNode::nextDrawCall(const rive::Mat2D& m, ax::Color32 color,
+                                                     const AxmolGradientUniforms* gradient, AxmolImagePage* image) {
+    if (_drawCallCount == _drawCalls.size()) {
+        auto call = std::make_unique<DrawCall>();
+        call->command.setDrawType(ax::CustomCommand::DrawType::ELEMENT);
+        call->command.setPrimitiveType(ax::CustomCommand::PrimitiveType::TRIANGLE);
+        _drawCalls.push_back(std::move(call));
+    }
+
+    auto call = _drawCalls[_drawCallCount++].get();
+    _uniformsDirty = true;
+    call->image = rive::ref_rcp(image);
+    call->batchable = false;
+    call->indexStart = _indices.size();
+    call->indexCount = 0;
+    call->slots[0].matrix = m;
+    call->slots[0].color = color;
+    call->slotCount = 1;
+    setCallBlend(call, _blend, _blendMode);
+    call->command.getPipelineDescriptor().blendDescriptor.writeMask = ax::rhi::ColorWriteMask::ALL;
+    call->stencil = contentStencil();
+    if (gradient) {
+        call->gradient = *gradient;
+    } else {
+        call->gradient.type[0] = 0.0f;
+    }
+    return call;
+}
+
+AxmolStencilState AxmolMeshNode::contentStencil() const {
+    // Content only shows where every active clip incremented the stencil
+    AxmolStencilState stencil;
+    stencil.op = _clips.empty() ? AxmolStencilState::Op::none : AxmolStencilState::Op::test;
+    stencil.ref = static_cast<uint8_t>(_clips.size());
+    return stencil;
+}
+
+AxmolMeshNode::DrawCall* AxmolMeshNode::beginDraw(const rive::Mat2D& m, ax::Color32 color,
+                                                  const AxmolGradientUniforms* gradient, AxmolImagePage* image,
+                                                  bool batchable, uint32_t& slot) {
+    // Advanced draws each need a copy of the layer as it is right before them
+    batchable = batchable && !gradient && _blend != AxmolBlendState::advanced;
+    if (batchable && _drawCallCount > 0) {
+        // Only the last call, anything else would change the painter's order
+        auto last = _drawCalls[_drawCallCount - 1].get();
+        if (last->batchable && last->image.get() == image && last->stencil == contentStencil() &&
+            last->blend == _blend && last->blendMode == _blendMode && last->slotCount < MaxBatchSlots) {
+            if (last->mesh) moveToDynamic(last);
+            slot = last->slotCount++;
+            last->slots[slot].matrix = m;
+            last->slots[slot].color = color;
+            _uniformsDirty = true;
+            return last;
+        }
+    }
+
+    auto call = nextDrawCall(m, color, gradient, image);
+    call->batchable = batchable;
+    slot = 0;
+    return call;
+}
+
+void AxmolMeshNode::moveToDynamic(DrawCall* call) {
+    // The call is the last one, its indices land right where the next draw's will follow
+    auto mesh = call->mesh;
+    call->indexStart = _indices.size();
+    call->indexCount = mesh->indexCount();
+    appendIndices(appendVertices(mesh->vertices(), 0), mesh->indices());
+    AX_SAFE_RELEASE_NULL(call->mesh);
+}
+
+void AxmolMeshNode::drawMesh(AxmolGpuMesh* mesh, const rive::Mat2D& m, ax::Color32 color,
+                             const AxmolGradientUniforms* gradient) {
+    if (!mesh || mesh->indexCount() == 0) return;
+
+    uint32_t slot = 0;
+    auto call = beginDraw(m, color, gradient, nullptr, mesh->vertices().size() <= BatchMeshVertices, slot);
+    if (slot > 0) {
+        call->indexCount += mesh->indexCount();
+        appendIndices(appendVertices(mesh->vertices(), slot), mesh->indices());
+        return;
+    }
+    // Alone so far, drawn from its resident buffers unless a later draw joins it
+    AX_SAFE_RETAIN(mesh);
+    call->mesh = mesh;
+    call->indexStart = 0;
+    call->indexCount = mesh->indexCount();
+}
+
+void AxmolMeshNode::drawClipMesh(const AxmolClip& clip, AxmolStencilState stencil) {
+    auto call = nextDrawCall(clip.matrix, ax::Color32::WHITE, nullptr);
+    setCallBlend(call, AxmolBlendState::srcOver, 0);
+    AX_SAFE_RETAIN(clip.mesh);
+    call->mesh = clip.mesh;
+    call->indexStart = 0;
+    call->indexCount = clip.mesh->indexCount();
+    call->stencil = stencil;
+    call->command.getPipelineDescriptor().blendDescriptor.writeMask = ax::rhi::ColorWriteMask::NONE;
+}
+
+void AxmolMeshNode::pushClip(AxmolGpuMesh* mesh, const rive::Mat2D& m) {
+    AxmolClip clip;
+    clip.mesh = mesh;
+    clip.matrix = m;
+    AX_SAFE_RETAIN(mesh);
+    if (mesh && mesh->indexCount() > 0) {
+        // The tessellated clip has no overlapping triangles, and the equality test stops a
+        // pixel from being incremented twice anyway
+        drawClipMesh(clip, {AxmolStencilState::Op::increment, static_cast<uint8_t>(_clips.size())});
+    }
+    _clips.push_back(clip);
+}
+
+void AxmolMeshNode::popClip() {
+    if (_clips.empty()) return;
+
+    AxmolClip clip = _clips.back();
+    if (clip.mesh && clip.mesh->indexCount() > 0) {
+        // Only pixels at this depth were incremented by this clip, bring them back down
+        drawClipMesh(clip, {AxmolStencilState::Op::decrement, static_cast<uint8_t>(_clips.size())});
+    }
+    AX_SAFE_RELEASE(clip.mesh);
+    _clips.pop_back();
+}
+
+void AxmolMeshNode::setClips(const std::vector<AxmolClip>& clips) {
+    size_t common = 0;
+    while (common < clips.size() && common < _clips.size() && clips[common] == _clips[common]) {
+        ++common;
+    }
+    while (_clips.size() > common) {
+        popClip();
+    }
+    for (size_t i = common; i < clips.size(); ++i) {
+        pushClip(clips[i].mesh, clips[i].matrix);
+    }
+}
+
+uint32_t AxmolMeshNode::appendVertices(rive::Span<const rive::Vec2D> vertices, uint32_t slot) {
+    auto base = static_cast<uint32_t>(_vertices.size());
+    _vertices.resize(_vertices.size() + vertices.size());
+    AxmolMeshVertex* out = _vertices.data() + base;
+    for (const auto& v : vertices) {
+        out->position.set(v.x, v.y);
+        out->color = ax::Color32::WHITE;
+        out->slot = static_cast<float>(slot);
+        ++out;
+    }
+    _dirty = true;
+    return base;
+}
+
+void AxmolMeshNode::appendIndices(uint32_t base, rive::Span<const uint16_t> indices) {
+    _indices.reserve(_indices.size() + indices.size());
+    for (auto index : indices) {
+        _indices.push_back(base + index);
+    }
+}
+
+void AxmolMeshNode::drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                                  const rive::Mat2D& m, ax::Color32 color) {
+    if (vertices.empty() || indices.size() < 3) return;
+
+    uint32_t slot = 0;
+    auto call = beginDraw(m, color, nullptr, nullptr, true, slot);
+    uint32_t base = appendVertices(vertices, slot);
+
+    // Only whole triangles
+    size_t count = indices.size() - indices.size() % 3;
+    call->indexCount += count;
+    appendIndices(base, rive::Span<const uint16_t>(indices.data(), count));
+}
+
+void AxmolMeshNode::drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                                  const rive::Mat2D& m, const AxmolRenderShader* shader) {
+    size_t before = _vertices.size();
+    drawTriangles(vertices, indices, m, ax::Color32::WHITE);
+
+    // One shader evaluation per shared vertex, in the same local space as the gradient. Ours are
+    // the last ones, a resident mesh moved to join the batch went in before them.
+    if (_vertices.size() > before) {
+        shader->getColors(vertices, _vertices.data() + _vertices.size() - vertices.size());
+    }
+}
+
+void AxmolMeshNode::appendStripIndices(uint32_t base, size_t count) {
+    _indices.reserve(_indices.size() + (count - 2) * 3);
+    for (uint32_t i = 0; i + 2 < count; ++i) {
+        _indices.push_back(base + i);
+        _indices.push_back(base + i + 1);
+        _indices.push_back(base + i + 2);
+    }
+}
+
+void AxmolMeshNode::drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m, ax::Color32 color,
+                              const AxmolGradientUniforms* gradient) {
+    if (strip.size() < 3) return;
+
+    uint32_t slot = 0;
+    auto call = beginDraw(m, color, gradient, nullptr, true, slot);
+    call->indexCount += (strip.size() - 2) * 3;
+    appendStripIndices(appendVertices(strip, slot), strip.size());
+}
+
+void AxmolMeshNode::drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m,
+                              const AxmolRenderShader* shader) {
+    size_t before = _vertices.size();
+    drawStrip(strip, m, ax::Color32::WHITE);
+    if (_vertices.size() > before) {
+        shader->getColors(strip, _vertices.data() + _vertices.size() - strip.size());
+    }
+}
+
+void AxmolMeshNode::drawImage(const AxmolRenderImage* image, rive::Span<const rive::Vec2D> vertices,
+                              rive::Span<const rive::Vec2D> uvs, rive::Span<const uint16_t> indices,
+                              const rive::Mat2D& m, float opacity) {
+    if (!_imageProgram.program || !image || vertices.empty() || indices.size() < 3 || uvs.size() < vertices.size()) return;
+
+    ax::Color32 color(255, 255, 255, static_cast<uint8_t>(std::min(1.0f, std::max(0.0f, opacity)) * 255.0f + 0.5f));
+    // Images of one atlas page batch together
+    uint32_t slot = 0;
+    auto call = beginDraw(m, color, nullptr, image->page(), true, slot);
+    // uvs go to the GPU as Rive wrote them, the shader maps them into the page
+    image->uvTransform(call->slots[slot].uvTransform);
+
+    auto base = static_cast<uint32_t>(_imageVertices.size());
+    _imageVertices.resize(_imageVertices.size() + vertices.size());
+    AxmolImageVertex* out = _imageVertices.data() + base;
+    for (size_t i = 0; i < vertices.size(); ++i, ++out) {
+        out->position.set(vertices[i].x, vertices[i].y);
+        out->texCoord.set(uvs[i].x, uvs[i].y);
+        out->slot = static_cast<float>(slot);
+    }
+
+    size_t count = indices.size() - indices.size() % 3;
+    call->indexCount += count;
+    appendIndices(base, rive::Span<const uint16_t>(indices.data(), count));
+    _dirty = true;
+}
+
+void AxmolMeshNode::updateBuffers() {
+    _dirty = false;
+    if (_indices.empty()) return;
+
+    // Grow only, buffers are kept across frames
+    if (_vertices.size() > _vertexCapacity) {
+        _vertexCapacity = std::max(_vertices.size(), _vertexCapacity * 2);
+        AX_SAFE_RELEASE(_vertexBuffer);
+        _vertexBuffer = newBuffer(_vertexCapacity * sizeof(AxmolMeshVertex), ax::rhi::BufferType::VERTEX,
+                                  ax::rhi::BufferUsage::DYNAMIC);
+    }
+    if (_indices.size() > _indexCapacity) {
+        _indexCapacity = std::max(_indices.size(), _indexCapacity * 2);
+        AX_SAFE_RELEASE(_indexBuffer);
+        _indexBuffer = newBuffer(_indexCapacity * sizeof(uint32_t), ax::rhi::BufferType::INDEX,
+                                 ax::rhi::BufferUsage::DYNAMIC);
+    }
+
+    if (_imageVertices.size() > _imageVertexCapacity) {
+        _imageVertexCapacity = std::max(_imageVertices.size(), _imageVertexCapacity * 2);
+        AX_SAFE_RELEASE(_imageVertexBuffer);
+        _imageVertexBuffer = newBuffer(_imageVertexCapacity * sizeof(AxmolImageVertex), ax::rhi::BufferType::VERTEX,
+                                       ax::rhi::BufferUsage::DYNAMIC);
+    }
+
+    if (!_vertices.empty()) {
+        _vertexBuffer->updateData(_vertices.data(), _vertices.size() * sizeof(AxmolMeshVertex));
+    }
+    if (!_imageVertices.empty()) {
+        _imageVertexBuffer->updateData(_imageVertices.data(), _imageVertices.size() * sizeof(AxmolImageVertex));
+    }
+    _indexBuffer->updateData(_indices.data(), _indices.size() * sizeof(uint32_t));
+}
+
+bool AxmolMeshNode::prepareLayer(const ax::rhi::Viewport& viewport) {
+    // Covers the viewport from the target's origin, so pixels of the layer, its copy and the
+    // scene share their gl_FragCoord
+    const int width = viewport.x + static_cast<int>(viewport.w);
+    const int height = viewport.y + static_cast<int>(viewport.h);
+    if (_layerTarget && width == _layerWidth && height == _layerHeight) return true;
+
+    releaseLayer();
+    if (!_blitProgram || width <= 0 || height <= 0) return false;
+
+    ax::rhi::TextureDescriptor descriptor;
+    descriptor.width = width;
+    descriptor.height = height;
+    descriptor.textureUsage = ax::rhi::TextureUsage::RENDER_TARGET;
+    descriptor.textureFormat = ax::rhi::PixelFormat::RGBA8;
+    _layerTexture = new ax::Texture2D();
+    _layerTexture->updateTextureDescriptor(descriptor, true);
+    _backdropTexture = new ax::Texture2D();
+    _backdropTexture->updateTextureDescriptor(descriptor, true);
+    descriptor.textureFormat = ax::rhi::PixelFormat::D24S8;
+    _layerDepthStencil = new ax::Texture2D();
+    _layerDepthStencil->updateTextureDescriptor(descriptor);
+
+    auto driver = ax::rhi::DriverBase::getInstance();
+    _layerTarget = driver->newRenderTarget(ax::rhi::TargetBufferFlags::ALL, _layerTexture->getRHITexture(),
+                                           _layerDepthStencil->getRHITexture(), _layerDepthStencil->getRHITexture());
+    _backdropTarget = driver->newRenderTarget(ax::rhi::TargetBufferFlags::COLOR, _backdropTexture->getRHITexture(),
+                                              nullptr, nullptr);
+    if (!_layerTarget || !_backdropTarget) {
+        AXLOGD("AxmolMeshNode: can't create a %dx%d blend layer, advanced blend draws are skipped", width, height);
+        releaseLayer();
+        return false;
+    }
+    _copyProgramState->setTexture(_blitTextureLocation, 0, _layerTexture->getRHITexture());
+    _compositeProgramState->setTexture(_blitTextureLocation, 0, _layerTexture->getRHITexture());
+    _layerWidth = width;
+    _layerHeight = height;
+    _uniformsDirty = true; // Advanced calls bind the new backdrop
+    return true;
+}
+
+void AxmolMeshNode::releaseLayer() {
+    AX_SAFE_RELEASE_NULL(_layerTarget);
+    AX_SAFE_RELEASE_NULL(_backdropTarget);
+    AX_SAFE_RELEASE_NULL(_layerTexture);
+    AX_SAFE_RELEASE_NULL(_layerDepthStencil);
+    AX_SAFE_RELEASE_NULL(_backdropTexture);
+    _layerWidth = 0;
+    _layerHeight = 0;
+}
+
+void AxmolMeshNode::addBackdropCopy(ax::Renderer* renderer, DrawCall& call) {
+    if (!call.backdropCopy) {
+        call.backdropCopy = std::make_unique<BackdropCopy>();
+        auto& copy = call.backdropCopy->copy;
+        copy.setDrawType(ax::CustomCommand::DrawType::ELEMENT);
+        copy.setPrimitiveType(ax::CustomCommand::PrimitiveType::TRIANGLE);
+        copy.getPipelineDescriptor().programState = _copyProgramState;
+        copy.getPipelineDescriptor().blendDescriptor.blendEnabled = false;
+    }
+    auto& backdrop = *call.backdropCopy;
+
+    // The backdrop has no stencil, the call turns its own test on again after
+    backdrop.begin.init(_globalZOrder);
+    backdrop.begin.func = [this, renderer]() {
+        applyStencil(renderer, AxmolStencilState());
+        renderer->setRenderTarget(_backdropTarget);
+    };
+    renderer->addCommand(&backdrop.begin);
+
+    backdrop.copy.init(_globalZOrder, ax::Mat4::IDENTITY, 0);
+    backdrop.copy.setVertexBuffer(_quadVertexBuffer);
+    backdrop.copy.setIndexBuffer(_quadIndexBuffer, ax::CustomCommand::IndexFormat::U_SHORT);
+    backdrop.copy.setIndexDrawInfo(0, 6);
+    renderer->addCommand(&backdrop.copy);
+
+    backdrop.end.init(_globalZOrder);
+    backdrop.end.func = [this, renderer]() { renderer->setRenderTarget(_layerTarget); };
+    renderer->addCommand(&backdrop.end);
+}
+
+void AxmolMeshNode::draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) {
+    if (_drawCallCount == 0) return;
+    if (_dirty) updateBuffers();
+
+    // Anything but srcOver blends within the artboard's own layer, see the class comment
+    bool layered = false;
+    for (size_t i = 0; i < _drawCallCount && !layered; ++i) {
+        layered = _drawCalls[i]->blend != AxmolBlendState::srcOver;
+    }
+    layered = layered && prepareLayer(renderer->getViewport());
+    if (layered) {
+        _beginLayerCommand.init(_globalZOrder);
+        _beginLayerCommand.func = [this, renderer]() {
+            _frameTarget = renderer->getRenderTarget();
+            renderer->setRenderTarget(_layerTarget);
+        };
+        renderer->addCommand(&_beginLayerCommand);
+        renderer->clear(ax::rhi::TargetBufferFlags::ALL, ax::Color(0.0f, 0.0f, 0.0f, 0.0f), 1.0f, 0, _globalZOrder);
+    }
+
+    const auto& projection = _director->getMatrix(ax::MATRIX_STACK_TYPE::MATRIX_STACK_PROJECTION);
+    ax::Mat4 mvp = projection * transform;
+
+    // Program states keep their uniforms, an idle frame with the same view only re-adds the commands
+    bool updateUniforms = _uniformsDirty || std::memcmp(mvp.m, _uniformsMvp.m, sizeof(mvp.m)) != 0;
+    _uniformsDirty = false;
+    _uniformsMvp = mvp;
+
+    AxmolStencilState currentStencil;
+    for (size_t i = 0; i < _drawCallCount; ++i) {
+        auto& call = *_drawCalls[i];
+        const bool advanced = call.blend == AxmolBlendState::advanced;
+        if (advanced) {
+            // Without a layer there is nothing to read, the draw is dropped
+            if (!layered) continue;
+            addBackdropCopy(renderer, call);
+            currentStencil = AxmolStencilState();
+        }
+
+        if (call.stencil != currentStencil) {
+            currentStencil = call.stencil;
+            call.stencilCommand.init(_globalZOrder);
+            call.stencilCommand.func = [renderer, currentStencil]() { applyStencil(renderer, currentStencil); };
+            renderer->addCommand(&call.stencilCommand);
+        }
+
+        if (updateUniforms) {
+            // Only the live slots, the rest of the arrays is never indexed
+            float affine[MaxBatchSlots * 4];
+            float translate[MaxBatchSlots * 4];
+            ax::Color colors[MaxBatchSlots];
+            float uvTransforms[MaxBatchSlots * 4];
+            for (uint32_t s = 0; s < call.slotCount; ++s) {
+                const auto& slot = call.slots[s];
+                const auto& m = slot.matrix;
+                for (int k = 0; k < 4; ++k) {
+                    affine[s * 4 + k] = m[k];
+                }
+                translate[s * 4 + 0] = m[4];
+                translate[s * 4 + 1] = m[5];
+                translate[s * 4 + 2] = 0.0f;
+                translate[s * 4 + 3] = 0.0f;
+                colors[s] = ax::Color(slot.color);
+                std::copy(slot.uvTransform, slot.uvTransform + 4, uvTransforms + s * 4);
+            }
+            const size_t vec4Size = call.slotCount * 4 * sizeof(float);
+
+            const float blendMode[4] = {static_cast<float>(call.blendMode), 0.0f, 0.0f, 0.0f};
+            auto programState = call.command.getPipelineDescriptor().programState;
+            if (call.image) {
+                const auto& program = advanced ? _imageBlendProgram : _imageProgram;
+                programState->setUniform(program.mvp, mvp.m, sizeof(mvp.m));
+                programState->setUniform(program.affine, affine, vec4Size);
+                programState->setUniform(program.translate, translate, vec4Size);
+                programState->setUniform(program.uvTransform, uvTransforms, vec4Size);
+                programState->setUniform(program.color, colors, vec4Size);
+                if (auto texture = call.image->texture()) {
+                    programState->setTexture(program.texture, 0, texture->getRHITexture());
+                }
+                if (advanced) {
+                    programState->setUniform(program.blendMode, blendMode, sizeof(blendMode));
+                    programState->setTexture(program.backdrop, 1, _backdropTexture->getRHITexture());
+                }
+            } else {
+                const auto& program = advanced ? _pathBlendProgram : _pathProgram;
+                programState->setUniform(program.mvp, mvp.m, sizeof(mvp.m));
+                programState->setUniform(program.affine, affine, vec4Size);
+                programState->setUniform(program.translate, translate, vec4Size);
+                programState->setUniform(program.color, colors, vec4Size);
+
+                const auto& gradient = call.gradient;
+                programState->setUniform(program.gradientType, gradient.type, sizeof(gradient.type));
+                if (gradient.type[0] > 0.0f) {
+                    programState->setUniform(program.gradientPoints, gradient.points, sizeof(gradient.points));
+                    programState->setUniform(program.stopOffsets, gradient.stopOffsets, sizeof(gradient.stopOffsets));
+                    programState->setUniform(program.stopColors, gradient.stopColors, sizeof(gradient.stopColors));
+                }
+                if (advanced) {
+                    programState->setUniform(program.blendMode, blendMode, sizeof(blendMode));
+                    programState->setTexture(program.backdrop, 0, _backdropTexture->getRHITexture());
+                }
+            }
+        }
+
+        call.command.init(_globalZOrder, transform, flags);
+        if (call.image) {
+            call.command.setVertexBuffer(_imageVertexBuffer);
+            call.command.setIndexBuffer(_indexBuffer, ax::CustomCommand::IndexFormat::U_INT);
+        } else if (call.mesh) {
+            call.command.setVertexBuffer(call.mesh->vertexBuffer());
+            call.command.setIndexBuffer(call.mesh->indexBuffer(), ax::CustomCommand::IndexFormat::U_SHORT);
+        } else {
+            call.command.setVertexBuffer(_vertexBuffer);
+            call.command.setIndexBuffer(_indexBuffer, ax::CustomCommand::IndexFormat::U_INT);
+        }
+        call.command.setIndexDrawInfo(call.indexStart, call.indexCount);
+        renderer->addCommand(&call.command);
+    }
+
+    if (currentStencil.op != AxmolStencilState::Op::none) {
+        _resetStencilCommand.init(_globalZOrder);
+        _resetStencilCommand.func = [renderer]() { applyStencil(renderer, AxmolStencilState()); };
+        renderer->addCommand(&_resetStencilCommand);
+    }
+
+    if (layered) {
+        // Back to the scene's target, the layer goes over it like any premultiplied draw
+        _endLayerCommand.init(_globalZOrder);
+        _endLayerCommand.func = [this, renderer]() { renderer->setRenderTarget(_frameTarget); };
+        renderer->addCommand(&_endLayerCommand);
+        _compositeCommand.init(_globalZOrder, ax::Mat4::IDENTITY, 0);
+        _compositeCommand.setVertexBuffer(_quadVertexBuffer);
+        _compositeCommand.setIndexBuffer(_quadIndexBuffer, ax::CustomCommand::IndexFormat::U_SHORT);
+        _compositeCommand.setIndexDrawInfo(0, 6);
+        renderer->addCommand(&_compositeCommand);
+    }
+}
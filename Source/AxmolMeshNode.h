@@ -0,0 +1,266 @@
+#ifndef _AXMOL_MESH_NODE_H_
+#define _AXMOL_MESH_NODE_H_
+
+#include "axmol/axmol.h"
+
+#include "AxmolRenderSink.h"
+#include "AxmolImageAtlas.h"
+
+#include <memory>
+#include <vector>
+
+// Stencil state of one draw. Clip meshes are drawn without color and move the stencil
+// value between 'ref' and the next depth, content tests for equality with the clip depth.
+struct AxmolStencilState {
+    enum class Op : uint8_t {
+        none,      // No clip active, stencil test off
+        test,      // Content inside the clip stack: stencil == ref
+        increment, // Clip push: stencil == ref -> ref + 1
+        decrement, // Clip pop: stencil == ref -> ref - 1
+    };
+
+    Op op = Op::none;
+    uint8_t ref = 0;
+
+    bool operator==(const AxmolStencilState& o) const { return op == o.op && ref == o.ref; }
+    bool operator!=(const AxmolStencilState& o) const { return !(*this == o); }
+};
+
+// Blending of a draw. Sources are premultiplied by the shaders. Part of the batch key, with
+// the shader blend mode for 'advanced'.
+enum class AxmolBlendState : uint8_t {
+    srcOver,   // ONE, ONE_MINUS_SRC_ALPHA
+    screen,    // ONE, ONE_MINUS_SRC_COLOR
+    exclusion, // ONE_MINUS_DST_COLOR, ONE_MINUS_SRC_COLOR
+    advanced,  // ONE, ZERO: the *_blend shaders composite over a copy of the layer themselves
+};
+
+// Node that submits Rive meshes with the rive_path program. Path fills reference their resident
+// AxmolGpuMesh; transient geometry (strokes, CPU shaded fills) goes through one dynamic buffer
+// owned by the node, images through a second one drawn with the rive_image program. Vertices
+// are never transformed on the CPU.
+//
+// Consecutive draws sharing program, texture, clip state and blending are merged into one
+// CustomCommand, in the order they were drawn. Each keeps its own matrix and paint color in a
+// slot of the batch's uniform arrays, vertices carry their slot. Gradient draws and clips are
+// never merged (their uniforms are per draw). A small resident mesh joining a batch is copied
+// into the dynamic buffer instead, large ones stay alone on their resident buffers.
+//
+// A frame using any blend mode besides srcOver is drawn into an offscreen layer (color and
+// stencil, the size of the viewport) composited over the scene at the end, so modes blend with
+// the artboard's own content like AxmolSoftwareSink. Screen and exclusion are exact with
+// fixed-function blending. Every other mode draws with rive_path_blend/rive_image_blend, which
+// read a copy of the layer made right before the draw: one full-viewport copy per such draw,
+// never batched. A stroke strip overlapping itself blends over its own earlier triangles there.
+// Without the blend programs those modes draw as srcOver and are logged once per mode.
+// Clipping is done here too, through the stencil buffer, so a whole artboard is a single node.
+class AxmolMeshNode : public ax::Node, public AxmolRenderSink {
+public:
+    // Draws per command at most, MAX_SLOTS of rive_path.vert and rive_image.vert
+    static constexpr uint32_t MaxBatchSlots = 16;
+    // Resident meshes with more vertices than this are never copied to join a batch
+    static constexpr size_t BatchMeshVertices = 256;
+
+    static AxmolMeshNode* create();
+
+    AxmolMeshNode() = default;
+    ~AxmolMeshNode() override;
+
+    bool init() override;
+    void draw(ax::Renderer* renderer, const ax::Mat4& transform, uint32_t flags) override;
+
+    // Drops all draws, keeps GPU buffers and commands for reuse
+    void clear() override;
+
+    // Draws a resident path mesh with the matrix as uniform, optionally shaded by a gradient
+    void drawMesh(AxmolGpuMesh* mesh, const rive::Mat2D& m, ax::Color32 color,
+                  const AxmolGradientUniforms* gradient = nullptr) override;
+
+    // Draws local space geometry through the dynamic buffer
+    void drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                       const rive::Mat2D& m, ax::Color32 color);
+    // Same, but colors every vertex with the shader (evaluated at the local position)
+    void drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                       const rive::Mat2D& m, const AxmolRenderShader* shader) override;
+
+    // Draws a triangle strip (stroke output) as indexed triangles
+    void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m, ax::Color32 color,
+                   const AxmolGradientUniforms* gradient = nullptr) override;
+    void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m,
+                   const AxmolRenderShader* shader) override;
+
+    // Draws textured triangles through the image buffer, the page is kept until the next clear
+    void drawImage(const AxmolRenderImage* image, rive::Span<const rive::Vec2D> vertices, rive::Span<const rive::Vec2D> uvs,
+                   rive::Span<const uint16_t> indices, const rive::Mat2D& m, float opacity) override;
+
+    // Intersects the clip with 'mesh' drawn with 'm'. A null mesh clips everything.
+    void pushClip(AxmolGpuMesh* mesh, const rive::Mat2D& m);
+    // Undoes the last pushClip by drawing its mesh again with a stencil decrement
+    void popClip();
+    // Brings the applied clips to 'clips', only popping and pushing past their common prefix
+    void setClips(const std::vector<AxmolClip>& clips) override;
+    size_t getClipDepth() const { return _clips.size(); }
+    void setBlendMode(rive::BlendMode mode) override;
+
+    // Fixed-function state drawing 'mode' exactly, false when it needs the blend shaders
+    static bool blendStateFor(rive::BlendMode mode, AxmolBlendState& state);
+    // u_blendMode of the blend shaders for 'mode', 0 for the fixed-function modes
+    static int blendShaderMode(rive::BlendMode mode);
+
+    size_t getDrawCallCount() const override { return _drawCallCount; }
+
+private:
+    // Uniforms of rive_path and rive_path_blend
+    struct PathProgram {
+        ax::rhi::Program* program = nullptr;
+        ax::rhi::UniformLocation mvp;
+        ax::rhi::UniformLocation affine;
+        ax::rhi::UniformLocation translate;
+        ax::rhi::UniformLocation color; // Per slot, in the vertex stage
+        ax::rhi::UniformLocation gradientType;
+        ax::rhi::UniformLocation gradientPoints;
+        ax::rhi::UniformLocation stopOffsets;
+        ax::rhi::UniformLocation stopColors;
+        ax::rhi::UniformLocation blendMode; // Blend programs only
+        ax::rhi::UniformLocation backdrop;
+
+        bool load(const char* fragmentShader);
+    };
+
+    // Uniforms of rive_image and rive_image_blend
+    struct ImageProgram {
+        ax::rhi::Program* program = nullptr;
+        ax::rhi::UniformLocation mvp;
+        ax::rhi::UniformLocation affine;
+        ax::rhi::UniformLocation translate;
+        ax::rhi::UniformLocation uvTransform;
+        ax::rhi::UniformLocation color;
+        ax::rhi::UniformLocation texture;
+        ax::rhi::UniformLocation blendMode; // Blend programs only
+        ax::rhi::UniformLocation backdrop;
+
+        bool load(const char* fragmentShader);
+    };
+
+    // Commands copying the layer to the backdrop before an advanced draw
+    struct BackdropCopy {
+        ax::CallbackCommand begin; // Stencil off, backdrop bound
+        ax::CustomCommand copy;
+        ax::CallbackCommand end; // Layer bound again
+    };
+
+    // One draw of a batch
+    struct Slot {
+        rive::Mat2D matrix;
+        ax::Color32 color;
+        float uvTransform[4] = {}; // Image uv to page uv, see AxmolRenderImage::uvTransform
+    };
+
+    struct DrawCall {
+        ~DrawCall();
+
+        ax::CustomCommand command;
+        // Issued before 'command' when the stencil state differs from the previous draw
+        ax::CallbackCommand stencilCommand;
+        AxmolStencilState stencil;
+        AxmolBlendState blend = AxmolBlendState::srcOver;
+        int blendMode = 0; // blendShaderMode, set with AxmolBlendState::advanced
+        ax::rhi::ProgramState* programState = nullptr;
+        ax::rhi::ProgramState* imageProgramState = nullptr; // Made for the first image drawn by this call
+        ax::rhi::ProgramState* blendProgramState = nullptr; // Same, for the first advanced draw
+        ax::rhi::ProgramState* imageBlendProgramState = nullptr;
+        std::unique_ptr<BackdropCopy> backdropCopy; // Made for the first advanced draw
+        AxmolGpuMesh* mesh = nullptr; // Retained, null when drawing from the dynamic buffer
+        rive::rcp<AxmolImagePage> image; // Set for image draws, which use the image buffer
+        bool batchable = false;          // Later draws with the same state may join
+        size_t indexStart = 0;
+        size_t indexCount = 0;
+        Slot slots[MaxBatchSlots];
+        uint32_t slotCount = 0;
+        AxmolGradientUniforms gradient; // Copied, the paint may change its shader before we render
+    };
+
+    // Program state of a call for its image page and blending, made on first use
+    ax::rhi::ProgramState* programStateFor(DrawCall* call, bool image, bool advanced);
+    // Stencil state of content drawn inside the current clips
+    AxmolStencilState contentStencil() const;
+    // Starts a draw: joins the last call when 'batchable' and its state matches, else opens a
+    // new one. 'slot' is where the draw's matrix and color went in the call.
+    DrawCall* beginDraw(const rive::Mat2D& m, ax::Color32 color, const AxmolGradientUniforms* gradient,
+                        AxmolImagePage* image, bool batchable, uint32_t& slot);
+    // New call with one slot and no geometry yet
+    DrawCall* nextDrawCall(const rive::Mat2D& m, ax::Color32 color, const AxmolGradientUniforms* gradient,
+                           AxmolImagePage* image = nullptr);
+    // Copies the resident mesh of a call into the dynamic buffer, so other draws can follow it there
+    void moveToDynamic(DrawCall* call);
+    // Adds a colorless draw of the clip mesh with the given stencil op
+    void drawClipMesh(const AxmolClip& clip, AxmolStencilState stencil);
+    // Copies the vertices into the dynamic buffer and returns the index of the first one
+    uint32_t appendVertices(rive::Span<const rive::Vec2D> vertices, uint32_t slot);
+    void appendIndices(uint32_t base, rive::Span<const uint16_t> indices);
+    void appendStripIndices(uint32_t base, size_t count);
+    void updateBuffers();
+    // (Re)creates the layer and backdrop targets for the viewport, false when they can't be made
+    bool prepareLayer(const ax::rhi::Viewport& viewport);
+    void releaseLayer();
+    // Adds the commands copying the layer to the backdrop right before 'call'
+    void addBackdropCopy(ax::Renderer* renderer, DrawCall& call);
+    // Sets the blending of a call, and the program state drawing with it
+    void setCallBlend(DrawCall* call, AxmolBlendState blend, int blendMode);
+
+    // Dynamic geometry of this frame
+    std::vector<AxmolMeshVertex> _vertices;
+    std::vector<uint32_t> _indices; // Into _vertices or _imageVertices, depending on the draw
+    std::vector<AxmolImageVertex> _imageVertices;
+    ax::rhi::Buffer* _vertexBuffer = nullptr;
+    ax::rhi::Buffer* _indexBuffer = nullptr;
+    ax::rhi::Buffer* _imageVertexBuffer = nullptr;
+    size_t _vertexCapacity = 0;
+    size_t _indexCapacity = 0;
+    size_t _imageVertexCapacity = 0;
+    bool _dirty = false;
+
+    // Pooled across frames, only the first _drawCallCount are live
+    std::vector<std::unique_ptr<DrawCall>> _drawCalls;
+    size_t _drawCallCount = 0;
+    // Uniforms are only set again after new draws or a view change
+    bool _uniformsDirty = true;
+    ax::Mat4 _uniformsMvp;
+
+    // Currently applied clips (meshes retained), the stencil value inside all of them is _clips.size()
+    std::vector<AxmolClip> _clips;
+    AxmolBlendState _blend = AxmolBlendState::srcOver;
+    int _blendMode = 0;
+    // Turns the stencil test off again after the last draw
+    ax::CallbackCommand _resetStencilCommand;
+
+    PathProgram _pathProgram;
+    // Images are skipped when rive_image isn't available
+    ImageProgram _imageProgram;
+    // Advanced modes draw as srcOver when these aren't available
+    PathProgram _pathBlendProgram;
+    ImageProgram _imageBlendProgram;
+
+    // Offscreen layer of blended frames (color, depth and stencil) and the copy advanced draws read.
+    // Kept at the viewport size while the node lives.
+    ax::Texture2D* _layerTexture = nullptr;
+    ax::Texture2D* _layerDepthStencil = nullptr;
+    ax::rhi::RenderTarget* _layerTarget = nullptr;
+    ax::Texture2D* _backdropTexture = nullptr;
+    ax::rhi::RenderTarget* _backdropTarget = nullptr;
+    int _layerWidth = 0;
+    int _layerHeight = 0;
+    ax::rhi::RenderTarget* _frameTarget = nullptr; // What the scene renders into, while the layer is bound
+    // rive_blit: full viewport quad, copying the layer with blending off or compositing it over the scene
+    ax::rhi::Program* _blitProgram = nullptr;
+    ax::rhi::ProgramState* _copyProgramState = nullptr;      // Samples the layer
+    ax::rhi::ProgramState* _compositeProgramState = nullptr; // Same, blended over
+    ax::rhi::UniformLocation _blitTextureLocation;
+    ax::rhi::Buffer* _quadVertexBuffer = nullptr;
+    ax::rhi::Buffer* _quadIndexBuffer = nullptr;
+    ax::CallbackCommand _beginLayerCommand;
+    ax::CallbackCommand _endLayerCommand;
+    ax::CustomCommand _compositeCommand;
+};
+
+#endif // _AXMOL_MESH_NODE_H_
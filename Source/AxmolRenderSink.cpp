@@ -0,0 +1,43 @@
+#include "AxmolRenderSink.h"
+
+// AxmolGpuMesh Implementation
+AxmolGpuMesh::AxmolGpuMesh(uint64_t geometryId, rive::Span<const rive::Vec2D> vertices,
+                           rive::Span<const uint16_t> indices)
+    : _geometryId(geometryId)
+    , _vertices(vertices.begin(), vertices.end())
+    , _indices(indices.begin(), indices.end()) {
+    // Only whole triangles
+    _indexCount = _indices.size() - _indices.size() % 3;
+}
+
+AxmolGpuMesh::~AxmolGpuMesh() {
+    AX_SAFE_RELEASE(_vertexBuffer);
+    AX_SAFE_RELEASE(_indexBuffer);
+}
+
+ax::rhi::Buffer* AxmolGpuMesh::vertexBuffer() {
+    if (!_vertexBuffer) upload();
+    return _vertexBuffer;
+}
+
+ax::rhi::Buffer* AxmolGpuMesh::indexBuffer() {
+    if (!_indexBuffer) upload();
+    return _indexBuffer;
+}
+
+void AxmolGpuMesh::upload() {
+    // Uploaded once, color comes from the paint uniform
+    std::vector<AxmolMeshVertex> data(_vertices.size());
+    for (size_t i = 0; i < _vertices.size(); ++i) {
+        data[i].position.set(_vertices[i].x, _vertices[i].y);
+        data[i].color = ax::Color32::WHITE;
+    }
+
+    auto driver = ax::rhi::DriverBase::getInstance();
+    size_t vertexSize = data.size() * sizeof(AxmolMeshVertex);
+    size_t indexSize = _indexCount * sizeof(uint16_t);
+    _vertexBuffer = driver->newBuffer(vertexSize, ax::rhi::BufferType::VERTEX, ax::rhi::BufferUsage::STATIC);
+    _vertexBuffer->updateData(data.data(), vertexSize);
+    _indexBuffer = driver->newBuffer(indexSize, ax::rhi::BufferType::INDEX, ax::rhi::BufferUsage::STATIC);
+    _indexBuffer->updateData(_indices.data(), indexSize);
+}
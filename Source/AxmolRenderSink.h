@@ -0,0 +1,120 @@
+#ifndef _AXMOL_RENDER_SINK_H_
+#define _AXMOL_RENDER_SINK_H_
+
+#include "axmol/axmol.h"
+
+#include "rive/span.hpp"
+#include "rive/math/vec2d.hpp"
+#include "rive/math/mat2d.hpp"
+
+#include <vector>
+
+class AxmolRenderShader;
+class AxmolRenderImage;
+
+// Vertex layout shared by the rive_path program: local position + per-vertex color, and the
+// slot of the draw in its batch (which matrix and paint color apply)
+struct AxmolMeshVertex {
+    ax::Vec2 position;
+    ax::Color32 color;
+    float slot = 0.0f;
+};
+
+// Vertex layout of the rive_image program: local position + image uv + batch slot
+struct AxmolImageVertex {
+    ax::Vec2 position;
+    ax::Vec2 texCoord;
+    float slot = 0.0f;
+};
+
+// Fragment uniforms of the rive_path program for gradient paints, see rive_path.frag
+struct AxmolGradientUniforms {
+    static constexpr size_t MaxStops = 16;
+
+    float type[4] = {};   // x: 0 none, 1 linear, 2 radial. y: stop count
+    float points[4] = {}; // Linear: start, end. Radial: center, radius
+    float stopOffsets[MaxStops] = {};
+    float stopColors[MaxStops * 4] = {};
+};
+
+// One path triangulation, immutable and kept resident across frames. The local space copy
+// is what software sinks read; the GPU buffers are only created on the first GPU draw,
+// which then applies the draw transform in the vertex shader.
+class AxmolGpuMesh : public ax::Object {
+public:
+    AxmolGpuMesh(uint64_t geometryId, rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices);
+    ~AxmolGpuMesh() override;
+
+    uint64_t geometryId() const { return _geometryId; }
+    rive::Span<const rive::Vec2D> vertices() const { return {_vertices.data(), _vertices.size()}; }
+    rive::Span<const uint16_t> indices() const { return {_indices.data(), _indexCount}; }
+    size_t indexCount() const { return _indexCount; }
+
+    // Uploads on first use
+    ax::rhi::Buffer* vertexBuffer();
+    ax::rhi::Buffer* indexBuffer();
+
+private:
+    void upload();
+
+    uint64_t _geometryId = 0;
+    std::vector<rive::Vec2D> _vertices;
+    std::vector<uint16_t> _indices;
+    ax::rhi::Buffer* _vertexBuffer = nullptr;
+    ax::rhi::Buffer* _indexBuffer = nullptr;
+    size_t _indexCount = 0;
+};
+
+// One entry of a clip stack: a resident clip mesh and the matrix it is drawn with.
+// Meshes are unique per triangulation, so two entries are the same clip when both fields match.
+struct AxmolClip {
+    AxmolGpuMesh* mesh = nullptr;
+    rive::Mat2D matrix;
+
+    bool operator==(const AxmolClip& o) const {
+        if (mesh != o.mesh) return false;
+        for (int i = 0; i < 6; ++i) {
+            if (matrix[i] != o.matrix[i]) return false;
+        }
+        return true;
+    }
+    bool operator!=(const AxmolClip& o) const { return !(*this == o); }
+};
+
+// Where AxmolRenderer sends its geometry. All geometry is in path-local space, 'm' maps it
+// to the output. AxmolMeshNode records it as Axmol render commands, AxmolSoftwareSink
+// rasterizes it into memory without a GPU.
+class AxmolRenderSink {
+public:
+    virtual ~AxmolRenderSink() = default;
+
+    // Start of a frame, drops everything from the previous one
+    virtual void clear() = 0;
+
+    // Resident path triangulation with a paint color, optionally shaded by a gradient
+    virtual void drawMesh(AxmolGpuMesh* mesh, const rive::Mat2D& m, ax::Color32 color,
+                          const AxmolGradientUniforms* gradient = nullptr) = 0;
+    // Triangles colored by a CPU shader, for gradients the uniforms can't hold
+    virtual void drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                               const rive::Mat2D& m, const AxmolRenderShader* shader) = 0;
+    // Triangle strip (stroke output)
+    virtual void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m, ax::Color32 color,
+                           const AxmolGradientUniforms* gradient = nullptr) = 0;
+    virtual void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m,
+                           const AxmolRenderShader* shader) = 0;
+    // Triangles textured with 'image', 'uvs' (one per vertex) in the image's own 0..1 space.
+    // The spans may point into mapped AxmolRenderBuffers, they are only valid during the call.
+    virtual void drawImage(const AxmolRenderImage* image, rive::Span<const rive::Vec2D> vertices,
+                           rive::Span<const rive::Vec2D> uvs, rive::Span<const uint16_t> indices,
+                           const rive::Mat2D& m, float opacity) = 0;
+
+    // Following draws are clipped to the intersection of 'clips'
+    virtual void setClips(const std::vector<AxmolClip>& clips) = 0;
+    // Following draws blend with 'mode', srcOver again after clear()
+    virtual void setBlendMode(rive::BlendMode mode) = 0;
+
+    // Draw commands the draws since the last clear turned into, after any batching
+    virtual size_t getDrawCallCount() const = 0;
+};
+
+#endif // _AXMOL_RENDER_SINK_H_
@@ -1,6 +1,16 @@
 #include "AxmolRive.h"
+#include "AxmolKernels.h"
+#include "AxmolJobs.h"
+
+#include "rive/file.hpp"
+#include "rive/file_asset_loader.hpp"
+#include "rive/assets/image_asset.hpp"
 
 #include <algorithm> // For std::min, std::max, std::lower_bound
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <cmath>
 
 // Helper to convert Rive ColorInt to Axmol Color32
 static ax::Color32 toAxColor(rive::ColorInt color) {
@@ -11,353 +21,1200 @@ static ax::Color32 toAxColor(rive::ColorInt color) {
     return ax::Color32(r, g, b, a);
 }
 
+// Copies the stops into the shader uniforms, false if there are more than the shader supports
+static bool fillStopUniforms(const std::vector<rive::ColorInt>& colors, const std::vector<float>& stops,
+                             AxmolGradientUniforms& out) {
+    if (colors.empty() || colors.size() > AxmolGradientUniforms::MaxStops) return false;
+
+    out.type[1] = static_cast<float>(colors.size());
+    for (size_t i = 0; i < colors.size(); ++i) {
+        out.stopOffsets[i] = stops[i];
+        out.stopColors[i * 4 + 0] = rive::colorRed(colors[i]) / 255.0f;
+        out.stopColors[i * 4 + 1] = rive::colorGreen(colors[i]) / 255.0f;
+        out.stopColors[i * 4 + 2] = rive::colorBlue(colors[i]) / 255.0f;
+        out.stopColors[i * 4 + 3] = rive::colorAlpha(colors[i]) / 255.0f;
+    }
+    return true;
+}
+
+// Gradient parameters are computed by the batch kernels in chunks of this many points
+static constexpr size_t kShadeChunk = 64;
+
+// AxmolRenderShader Implementation
+void AxmolRenderShader::getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const {
+    for (size_t i = 0; i < points.size(); ++i) {
+        out[i].color = getColor(points[i].x, points[i].y);
+    }
+}
+
+// AxmolColorRamp Implementation
+void AxmolColorRamp::bake(const rive::ColorInt colors[], const float stops[], size_t count) {
+    if (count == 0) {
+        _colors.fill(ax::Color32::WHITE);
+        return;
+    }
+    
+    // Same interpolation as the stop scan it replaces (and as rive_path.frag),
+    // done once per entry instead of once per lookup
+    size_t stop = 0;
+    for (int i = 0; i < Size; ++i) {
+        float t = static_cast<float>(i) / (Size - 1);
+        if (t <= stops[0]) {
+            _colors[i] = toAxColor(colors[0]);
+            continue;
+        }
+        if (t >= stops[count - 1]) {
+            _colors[i] = toAxColor(colors[count - 1]);
+            continue;
+        }
+        // Entries are visited in increasing t, the stop only moves forward
+        while (stop + 2 < count && t > stops[stop + 1]) {
+            ++stop;
+        }
+        float range = stops[stop + 1] - stops[stop];
+        float localT = (t - stops[stop]) / (range > 0 ? range : 1.0f);
+        _colors[i] = toAxColor(rive::colorLerp(colors[stop], colors[stop + 1], localT));
+    }
+}
+
 // AxmolLinearGradient Implementation
 AxmolLinearGradient::AxmolLinearGradient(float sx, float sy, float ex, float ey,
                                          const rive::ColorInt colors[], const float stops[], size_t count) 
     : _start(sx, sy), _end(ex, ey) {
     _diff = _end - _start;
     _lenSq = _diff.lengthSquared();
+    _invLenSq = _lenSq > 0.0001f ? 1.0f / _lenSq : 0.0f;
     for (size_t i = 0; i < count; ++i) {
         _colors.push_back(colors[i]);
         _stops.push_back(stops[i]);
     }
+    _ramp.bake(colors, stops, count);
 }
 
 ax::Color32 AxmolLinearGradient::getColor(float x, float y) const {
     if (_colors.empty()) return ax::Color32::WHITE;
     if (_lenSq <= 0.0001f) return toAxColor(_colors[0]);
 
-    rive::Vec2D p(x, y);
-    rive::Vec2D v = p - _start;
-    float t = rive::Vec2D::dot(v, _diff) / _lenSq;
-    t = std::max(0.0f, std::min(1.0f, t));
-
-    // Find stop
-    // Assuming sorted stops (Rive usually does). If not, we should sort.
-    // Simple scan
-    if (t <= _stops.front()) return toAxColor(_colors.front());
-    if (t >= _stops.back()) return toAxColor(_colors.back());
-
-    for (size_t i = 0; i < _stops.size() - 1; ++i) {
-        if (t >= _stops[i] && t <= _stops[i+1]) {
-            float range = _stops[i+1] - _stops[i];
-            float localT = (t - _stops[i]) / (range > 0 ? range : 1.0f);
-            return toAxColor(rive::colorLerp(_colors[i], _colors[i+1], localT));
+    float t = ((x - _start.x) * _diff.x + (y - _start.y) * _diff.y) * _invLenSq;
+    return _ramp.at(t);
+}
+
+void AxmolLinearGradient::getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const {
+    if (_colors.empty() || _lenSq <= 0.0001f) {
+        AxmolRenderShader::getColors(points, out);
+        return;
+    }
+    
+    float t[kShadeChunk];
+    for (size_t first = 0; first < points.size(); first += kShadeChunk) {
+        size_t count = std::min(kShadeChunk, points.size() - first);
+        AxmolKernels::linearGradientT(&points[first].x, count, _start.x, _start.y,
+                                      _diff.x * _invLenSq, _diff.y * _invLenSq, t);
+        for (size_t i = 0; i < count; ++i) {
+            out[first + i].color = _ramp.at(t[i]);
         }
     }
-    return toAxColor(_colors.back());
+}
+
+bool AxmolLinearGradient::gradientUniforms(AxmolGradientUniforms& out) const {
+    if (!fillStopUniforms(_colors, _stops, out)) return false;
+    out.type[0] = 1.0f;
+    out.points[0] = _start.x;
+    out.points[1] = _start.y;
+    out.points[2] = _end.x;
+    out.points[3] = _end.y;
+    return true;
 }
 
 // AxmolRadialGradient Implementation
 AxmolRadialGradient::AxmolRadialGradient(float cx, float cy, float radius,
                                          const rive::ColorInt colors[], const float stops[], size_t count)
     : _center(cx, cy), _radius(radius) {
+    _invRadius = _radius > 0.0001f ? 1.0f / _radius : 0.0f;
+    _innerDistSq = 0.0f;
+    _outerDistSq = _radius * _radius;
+    if (count > 0) {
+        float inner = std::max(0.0f, stops[0]) * _radius;
+        float outer = std::min(1.0f, stops[count - 1]) * _radius;
+        _innerDistSq = inner * inner;
+        _outerDistSq = outer * outer;
+    }
     for (size_t i = 0; i < count; ++i) {
         _colors.push_back(colors[i]);
         _stops.push_back(stops[i]);
     }
+    _ramp.bake(colors, stops, count);
 }
 
 ax::Color32 AxmolRadialGradient::getColor(float x, float y) const {
     if (_colors.empty()) return ax::Color32::WHITE;
     if (_radius <= 0.0001f) return toAxColor(_colors[0]);
 
-    rive::Vec2D p(x, y);
-    float dist = rive::Vec2D::distance(p, _center);
-    float t = dist / _radius;
-    t = std::max(0.0f, std::min(1.0f, t));
+    float dx = x - _center.x;
+    float dy = y - _center.y;
+    float distSq = dx * dx + dy * dy;
+    // Outside the stop range the color is constant, no need for the distance
+    if (distSq <= _innerDistSq) return toAxColor(_colors.front());
+    if (distSq >= _outerDistSq) return toAxColor(_colors.back());
 
-    if (t <= _stops.front()) return toAxColor(_colors.front());
-    if (t >= _stops.back()) return toAxColor(_colors.back());
+    return _ramp.at(std::sqrt(distSq) * _invRadius);
+}
 
-    for (size_t i = 0; i < _stops.size() - 1; ++i) {
-        if (t >= _stops[i] && t <= _stops[i+1]) {
-            float range = _stops[i+1] - _stops[i];
-            float localT = (t - _stops[i]) / (range > 0 ? range : 1.0f);
-            return toAxColor(rive::colorLerp(_colors[i], _colors[i+1], localT));
+void AxmolRadialGradient::getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const {
+    if (_colors.empty() || _radius <= 0.0001f) {
+        AxmolRenderShader::getColors(points, out);
+        return;
+    }
+    
+    // The vector sqrt is cheap enough that the per-point early outs of getColor don't pay off here
+    float t[kShadeChunk];
+    for (size_t first = 0; first < points.size(); first += kShadeChunk) {
+        size_t count = std::min(kShadeChunk, points.size() - first);
+        AxmolKernels::radialGradientT(&points[first].x, count, _center.x, _center.y, _invRadius, t);
+        for (size_t i = 0; i < count; ++i) {
+            out[first + i].color = _ramp.at(t[i]);
         }
     }
-    return toAxColor(_colors.back());
+}
+
+bool AxmolRadialGradient::gradientUniforms(AxmolGradientUniforms& out) const {
+    if (!fillStopUniforms(_colors, _stops, out)) return false;
+    out.type[0] = 2.0f;
+    out.points[0] = _center.x;
+    out.points[1] = _center.y;
+    out.points[2] = _radius;
+    out.points[3] = 0.0f;
+    return true;
+}
+
+// Process-wide so ids are never reused by another path or paint, even one from another factory
+// at the same address: caches can key on them alone. Shared between threads like the fast
+// path switches below.
+static uint64_t nextGeometryId() {
+    static std::atomic<uint64_t> s_nextGeometryId{1};
+    return s_nextGeometryId.fetch_add(1, std::memory_order_relaxed);
+}
+
+static std::atomic<bool> s_fastPaths{true};
+static std::atomic<bool> s_fastPathValidation{false};
+static std::atomic<uint64_t> s_fastPathMismatches{0};
+
+void AxmolRenderPath::setFastPaths(bool enabled) {
+    s_fastPaths.store(enabled, std::memory_order_relaxed);
+}
+
+void AxmolRenderPath::setFastPathValidation(bool enabled) {
+    s_fastPathValidation.store(enabled, std::memory_order_relaxed);
+}
+
+uint64_t AxmolRenderPath::getFastPathMismatchCount() {
+    return s_fastPathMismatches.load(std::memory_order_relaxed);
+}
+
+// Inverted, any point expands it to that point
+static rive::AABB emptyBounds() {
+    const float inf = std::numeric_limits<float>::infinity();
+    return rive::AABB(inf, inf, -inf, -inf);
+}
+
+static void expandBounds(rive::AABB& bounds, rive::Vec2D point) {
+    bounds.minX = std::min(bounds.minX, point.x);
+    bounds.minY = std::min(bounds.minY, point.y);
+    bounds.maxX = std::max(bounds.maxX, point.x);
+    bounds.maxY = std::max(bounds.maxY, point.y);
+}
+
+// One move, and nothing after a close: the contour is a single closed polygon
+static bool isSingleContour(const rive::RawPath& rawPath) {
+    auto verbs = rawPath.verbs();
+    int moves = 0;
+    for (size_t i = 0; i < verbs.size(); ++i) {
+        if (verbs[i] == rive::PathVerb::move && ++moves > 1) return false;
+        if (verbs[i] == rive::PathVerb::close && i + 1 != verbs.size()) return false;
+    }
+    return moves == 1;
+}
+
+static float turn(rive::Vec2D a, rive::Vec2D b, rive::Vec2D c) {
+    return (b.x - a.x) * (c.y - b.y) - (b.y - a.y) * (c.x - b.x);
+}
+
+// Every turn the same way (straight runs allowed) and the contour winds around only once:
+// x changes direction at most twice. Exact comparisons, anything in doubt is tessellated.
+static bool isConvex(const std::vector<rive::Vec2D>& points) {
+    const size_t n = points.size();
+    int sign = 0;
+    int xFlips = 0;
+    float lastDx = 0.0f;
+    for (size_t i = 0; i < n; ++i) {
+        const auto& a = points[i];
+        const auto& b = points[(i + 1) % n];
+        const auto& c = points[(i + 2) % n];
+        float t = turn(a, b, c);
+        if (t != 0.0f) {
+            int s = t > 0.0f ? 1 : -1;
+            if (sign != 0 && s != sign) return false;
+            sign = s;
+        }
+        float dx = b.x - a.x;
+        if (dx != 0.0f) {
+            if (lastDx != 0.0f && (dx > 0.0f) != (lastDx > 0.0f)) ++xFlips;
+            lastDx = dx;
+        }
+    }
+    // The wrap from the last edge back to the first
+    for (size_t i = 0; i < n; ++i) {
+        float dx = points[(i + 1) % n].x - points[i].x;
+        if (dx != 0.0f) {
+            if ((dx > 0.0f) != (lastDx > 0.0f)) ++xFlips;
+            break;
+        }
+    }
+    return sign != 0 && xFlips <= 2;
+}
+
+static bool isAxisAlignedRect(const std::vector<rive::Vec2D>& p) {
+    if (p.size() != 4) return false;
+    bool verticalFirst = p[0].x == p[1].x && p[1].y == p[2].y && p[2].x == p[3].x && p[3].y == p[0].y;
+    bool horizontalFirst = p[0].y == p[1].y && p[1].x == p[2].x && p[2].y == p[3].y && p[3].x == p[0].x;
+    return (verticalFirst || horizontalFirst) && p[0].x != p[2].x && p[0].y != p[2].y;
+}
+
+// Area and bounds covered by a triangle list, triangles of one triangulation never overlap
+static double coveredArea(const std::vector<rive::Vec2D>& vertices, const std::vector<uint16_t>& indices,
+                          rive::AABB& bounds) {
+    double area = 0.0;
+    bounds = rive::AABB(0.0f, 0.0f, 0.0f, 0.0f);
+    if (indices.empty()) return area;
+    const auto& first = vertices[indices[0]];
+    bounds = rive::AABB(first.x, first.y, first.x, first.y);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        const auto& v = vertices[indices[i]];
+        bounds.minX = std::min(bounds.minX, v.x);
+        bounds.minY = std::min(bounds.minY, v.y);
+        bounds.maxX = std::max(bounds.maxX, v.x);
+        bounds.maxY = std::max(bounds.maxY, v.y);
+    }
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        const auto& a = vertices[indices[i]];
+        const auto& b = vertices[indices[i + 1]];
+        const auto& c = vertices[indices[i + 2]];
+        area += std::abs(static_cast<double>(b.x - a.x) * (c.y - a.y) - static_cast<double>(b.y - a.y) * (c.x - a.x));
+    }
+    return area * 0.5;
 }
 
 // AxmolRenderPath Implementation
 AxmolRenderPath::AxmolRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule)
     : rive::TessRenderPath(rawPath, fillRule) {
+    bumpGeometryId();
+    _pathRevision = nextGeometryId();
+}
+
+AxmolRenderPath::~AxmolRenderPath() {
+    AX_SAFE_RELEASE(_gpuMesh);
+}
+
+void AxmolRenderPath::bumpGeometryId() {
+    _geometryId = nextGeometryId();
 }
 
 void AxmolRenderPath::rewind() {
     rive::TessRenderPath::rewind();
+    _subPaths.clear();
     _rawVertices.clear();
     _rawIndices.clear();
+    bumpGeometryId();
+    _pathRevision = nextGeometryId();
 }
 
-void AxmolRenderPath::prune(size_t oldVertexCount, size_t oldIndexCount) {
-    if (oldVertexCount == 0 && oldIndexCount == 0) return;
+void AxmolRenderPath::addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform) {
+    rive::TessRenderPath::addRenderPath(path, transform);
+    _subPaths.push_back(static_cast<AxmolRenderPath*>(path));
+}
+
+bool AxmolRenderPath::needsGeometry(const rive::Mat2D& transform) const {
+    const float linear[4] = {transform[0], transform[1], transform[2], transform[3]};
+    return _triangulatedId != _geometryId || !std::equal(linear, linear + 4, _triangulatedLinear);
+}
+
+bool AxmolRenderPath::updateGeometry(const rive::Mat2D& transform) {
+    if (!needsGeometry(transform)) {
+        return false;
+    }
+    const float linear[4] = {transform[0], transform[1], transform[2], transform[3]};
+    
+    contour(transform);
     
-    // 1. Shift vertices
-    if (oldVertexCount < _rawVertices.size()) {
-        // Move [oldVertexCount, end] to [0, ...]
-        std::copy(_rawVertices.begin() + oldVertexCount, _rawVertices.end(), _rawVertices.begin());
-        _rawVertices.resize(_rawVertices.size() - oldVertexCount);
+    _newVertices.clear();
+    _newIndices.clear();
+    _newBounds = emptyBounds();
+    bool changed;
+    Shape shape = s_fastPaths.load(std::memory_order_relaxed) ? triangulateFast() : Shape::general;
+    if (shape != Shape::general) {
+        if (s_fastPathValidation.load(std::memory_order_relaxed)) validateFastPath(shape);
+        // The contour only changes on rewind or for a new scale, most calls rebuild the same quad or strip
+        changed = _newVertices != _rawVertices || _newIndices != _rawIndices;
     } else {
-        _rawVertices.clear();
+        changed = triangulate();
+    }
+    if (changed) {
+        _rawVertices.swap(_newVertices);
+        _rawIndices.swap(_newIndices);
+        _shape = shape;
+        _bounds = _rawVertices.empty() ? rive::AABB(0.0f, 0.0f, 0.0f, 0.0f) : _newBounds;
+        _boundsRevision = _pathRevision;
+        bumpGeometryId();
     }
     
-    // 2. Shift indices and adjust values
-    if (oldIndexCount < _rawIndices.size()) {
-        size_t count = _rawIndices.size() - oldIndexCount;
-        for (size_t i = 0; i < count; ++i) {
-            _rawIndices[i] = _rawIndices[i + oldIndexCount] - oldVertexCount;
+    _triangulatedId = _geometryId;
+    std::copy(linear, linear + 4, _triangulatedLinear);
+    return changed;
+}
+
+AxmolRenderPath::Shape AxmolRenderPath::triangulateFast() {
+    // Containers keep their sub paths apart, they always go through triangulate()
+    if (!isSingleContour(rawPath())) return Shape::general;
+
+    // Contours may repeat points, the start one at the end in particular
+    auto& points = _newVertices;
+    for (const auto& point : segmentedContour().contourPoints()) {
+        if (points.empty() || point != points.back()) {
+            points.push_back(point);
+            expandBounds(_newBounds, point);
         }
-        _rawIndices.resize(count);
-    } else {
-        _rawIndices.clear();
     }
+    while (points.size() > 1 && points.back() == points.front()) {
+        points.pop_back();
+    }
+    const size_t n = points.size();
+    if (isAxisAlignedRect(points)) {
+        _newIndices.insert(_newIndices.end(), {0, 1, 2, 0, 2, 3});
+        return Shape::rect;
+    }
+    if (n < 3 || n > 0xFFFF || !isConvex(points)) {
+        // Left empty for triangulate()
+        points.clear();
+        _newBounds = emptyBounds();
+        return Shape::general;
+    }
+
+    // Zigzag between both ends (0, 1, n-1, 2, n-2, ...) instead of a fan, so the triangles of
+    // long curves don't all narrow down to one vertex
+    _newIndices.reserve((n - 2) * 3);
+    uint16_t a = 0;
+    uint16_t b = 1;
+    uint16_t low = 1;
+    uint16_t high = static_cast<uint16_t>(n - 1);
+    for (size_t i = 0; i + 2 < n; ++i) {
+        uint16_t c = (i % 2 == 0) ? high-- : ++low;
+        _newIndices.insert(_newIndices.end(), {a, b, c});
+        a = b;
+        b = c;
+    }
+    return Shape::convex;
+}
+
+void AxmolRenderPath::validateFastPath(Shape shape) {
+    std::vector<rive::Vec2D> fastVertices;
+    std::vector<uint16_t> fastIndices;
+    fastVertices.swap(_newVertices);
+    fastIndices.swap(_newIndices);
+    const rive::AABB fastBounds = _newBounds;
+    // Only when the tessellator's own cache is stale, it has nothing new to compare otherwise
+    if (triangulate()) {
+        rive::AABB fastBounds;
+        rive::AABB tessBounds;
+        double fastArea = coveredArea(fastVertices, fastIndices, fastBounds);
+        double tessArea = coveredArea(_newVertices, _newIndices, tessBounds);
+        auto near = [](double x, double y) {
+            return std::abs(x - y) <= 1e-4 * std::max(std::abs(x), std::abs(y)) + 1e-3;
+        };
+        if (!near(fastArea, tessArea) || !near(fastBounds.minX, tessBounds.minX) ||
+            !near(fastBounds.minY, tessBounds.minY) || !near(fastBounds.maxX, tessBounds.maxX) ||
+            !near(fastBounds.maxY, tessBounds.maxY)) {
+            s_fastPathMismatches.fetch_add(1, std::memory_order_relaxed);
+            AXLOGD("AxmolRenderPath: %s fast path covers %f, the tessellator %f",
+                   shape == Shape::rect ? "rect" : "convex", fastArea, tessArea);
+        }
+    }
+    _newVertices.swap(fastVertices);
+    _newIndices.swap(fastIndices);
+    _newBounds = fastBounds;
+}
+
+AxmolGpuMesh* AxmolRenderPath::gpuMesh() {
+    if (_gpuMesh && _gpuMesh->geometryId() == _geometryId) {
+        return _gpuMesh;
+    }
+    AX_SAFE_RELEASE_NULL(_gpuMesh);
+    if (_rawVertices.empty() || _rawIndices.empty()) {
+        return nullptr;
+    }
+    _gpuMesh = new AxmolGpuMesh(_geometryId,
+                                rive::Span<const rive::Vec2D>(_rawVertices.data(), _rawVertices.size()),
+                                rive::Span<const uint16_t>(_rawIndices.data(), _rawIndices.size()));
+    return _gpuMesh;
 }
 
 void AxmolRenderPath::addTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices) {
-    // Copy vertices and indices to storage
-    size_t baseIndex = _rawVertices.size();
-    
+    // Container paths add one batch per sub path, indices are rebased onto the merged vertices
+    size_t baseIndex = _newVertices.size();
+    _newVertices.reserve(baseIndex + vertices.size());
     for (const auto& v : vertices) {
-        _rawVertices.push_back(v);
+        _newVertices.push_back(v);
+        expandBounds(_newBounds, v);
     }
     
+    _newIndices.reserve(_newIndices.size() + indices.size());
     for (const auto& idx : indices) {
-        _rawIndices.push_back(static_cast<unsigned short>(baseIndex + idx));
+        _newIndices.push_back(static_cast<uint16_t>(baseIndex + idx));
     }
 }
 
 void AxmolRenderPath::setTriangulatedBounds(const rive::AABB& value) {
-    // Optional: Use this to optimize culling
+    // Reported once per (sub) path of a container, with its own bounds: merged with the
+    // vertices' rather than taken as the whole path's. Empty ones are inverted, nothing to merge.
+    if (value.minX > value.maxX || value.minY > value.maxY) return;
+    expandBounds(_newBounds, rive::Vec2D(value.minX, value.minY));
+    expandBounds(_newBounds, rive::Vec2D(value.maxX, value.maxY));
+}
+
+bool AxmolRenderPath::localBounds(rive::AABB& out) const {
+    if (_boundsRevision != _pathRevision) return false;
+    out = _bounds;
+    return true;
 }
 
 // AxmolRenderPaint Implementation
 AxmolRenderPaint::AxmolRenderPaint() {}
+AxmolRenderPaint::~AxmolRenderPaint() {
+    for (auto& stroke : _strokes) {
+        AX_SAFE_RELEASE(stroke.second.mesh);
+    }
+    for (auto mesh : _retiredMeshes) {
+        AX_SAFE_RELEASE(mesh);
+    }
+}
 void AxmolRenderPaint::style(rive::RenderPaintStyle style) { _style = style; }
 void AxmolRenderPaint::color(rive::ColorInt value) { _color = value; }
-void AxmolRenderPaint::thickness(float value) { _thickness = value; }
-void AxmolRenderPaint::join(rive::StrokeJoin value) { _join = value; }
-void AxmolRenderPaint::cap(rive::StrokeCap value) { _cap = value; }
+void AxmolRenderPaint::thickness(float value) {
+    if (value != _thickness) ++_styleRevision;
+    _thickness = value;
+}
+void AxmolRenderPaint::join(rive::StrokeJoin value) {
+    if (value != _join) ++_styleRevision;
+    _join = value;
+}
+void AxmolRenderPaint::cap(rive::StrokeCap value) {
+    if (value != _cap) ++_styleRevision;
+    _cap = value;
+}
 void AxmolRenderPaint::blendMode(rive::BlendMode value) { _blendMode = value; }
 void AxmolRenderPaint::shader(rive::rcp<rive::RenderShader> shader) { 
     _shader = rive::static_rcp_cast<AxmolRenderShader>(shader); 
 }
-void AxmolRenderPaint::invalidateStroke() { /* Handle invalidation if caching */ }
+void AxmolRenderPaint::invalidateStroke() { ++_styleRevision; }
+
+// The strip is local, the transform only sets the contour tolerance through its scale
+static float strokeScale(const rive::Mat2D& transform) {
+    return std::sqrt(std::abs(transform[0] * transform[3] - transform[1] * transform[2]));
+}
+
+const AxmolRenderPaint::Stroke* AxmolRenderPaint::currentStroke(const AxmolRenderPath* path) const {
+    auto it = _strokes.find(path);
+    if (it == _strokes.end()) return nullptr;
+    const Stroke& stroke = it->second;
+    return stroke.pathRevision == path->pathRevision() && stroke.styleRevision == _styleRevision ? &stroke : nullptr;
+}
+
+bool AxmolRenderPaint::needsStroke(const AxmolRenderPath* path, const rive::Mat2D& transform) const {
+    const Stroke* stroke = currentStroke(path);
+    if (!stroke) return true;
+    float scale = strokeScale(transform);
+    return !(scale <= stroke->scale * StrokeRescale && scale * StrokeRescale >= stroke->scale);
+}
+
+bool AxmolRenderPaint::updateStroke(AxmolRenderPath* path, const rive::Mat2D& transform) {
+    auto it = _strokes.find(path);
+    if (it != _strokes.end()) it->second.lastUse = ++_useClock;
+    if (!needsStroke(path, transform)) {
+        return false;
+    }
+
+    if (it == _strokes.end()) {
+        if (_strokes.size() >= MaxCachedStrokes) {
+            // Paths that went away or stopped being stroked, their revision never matches again
+            auto oldest = _strokes.begin();
+            for (auto s = _strokes.begin(); s != _strokes.end(); ++s) {
+                if (s->second.lastUse < oldest->second.lastUse) oldest = s;
+            }
+            if (oldest->second.mesh) _retiredMeshes.push_back(oldest->second.mesh);
+            _strokes.erase(oldest);
+        }
+        it = _strokes.emplace(path, Stroke()).first;
+        it->second.lastUse = ++_useClock;
+    }
+    Stroke& stroke = it->second;
+    stroke.contour.reset();
+    path->extrudeStroke(&stroke.contour, _join, _cap, _thickness, transform);
+    stroke.pathRevision = path->pathRevision();
+    stroke.styleRevision = _styleRevision;
+    stroke.scale = strokeScale(transform);
+    stroke.id = nextGeometryId();
+
+    const auto& strip = stroke.contour.triangleStrip();
+    stroke.bounds = rive::AABB(0.0f, 0.0f, 0.0f, 0.0f);
+    if (!strip.empty()) {
+        stroke.bounds = rive::AABB(strip[0].x, strip[0].y, strip[0].x, strip[0].y);
+        for (const auto& v : strip) {
+            stroke.bounds.minX = std::min(stroke.bounds.minX, v.x);
+            stroke.bounds.minY = std::min(stroke.bounds.minY, v.y);
+            stroke.bounds.maxX = std::max(stroke.bounds.maxX, v.x);
+            stroke.bounds.maxY = std::max(stroke.bounds.maxY, v.y);
+        }
+    }
+    return true;
+}
+
+const std::vector<rive::Vec2D>& AxmolRenderPaint::strokeStrip(const AxmolRenderPath* path) const {
+    static const std::vector<rive::Vec2D> s_noStrip;
+    const Stroke* stroke = currentStroke(path);
+    return stroke ? stroke->contour.triangleStrip() : s_noStrip;
+}
+
+bool AxmolRenderPaint::strokeBounds(const AxmolRenderPath* path, rive::AABB& out) const {
+    // Still right after a small scale change, the extrusion only gets finer or coarser
+    const Stroke* stroke = currentStroke(path);
+    if (!stroke) return false;
+    out = stroke->bounds;
+    return true;
+}
+
+AxmolGpuMesh* AxmolRenderPaint::strokeMesh(const AxmolRenderPath* path) {
+    for (auto mesh : _retiredMeshes) {
+        AX_SAFE_RELEASE(mesh);
+    }
+    _retiredMeshes.clear();
+
+    auto it = _strokes.find(path);
+    if (it == _strokes.end() || !currentStroke(path)) {
+        return nullptr;
+    }
+    Stroke& stroke = it->second;
+    if (stroke.mesh && stroke.mesh->geometryId() == stroke.id) {
+        return stroke.mesh;
+    }
+    AX_SAFE_RELEASE_NULL(stroke.mesh);
+    
+    const auto& strip = stroke.contour.triangleStrip();
+    if (strip.size() < 3 || strip.size() > 0x10000) {
+        return nullptr;
+    }
+    std::vector<uint16_t> indices;
+    indices.reserve((strip.size() - 2) * 3);
+    for (size_t i = 0; i + 2 < strip.size(); ++i) {
+        indices.push_back(static_cast<uint16_t>(i));
+        indices.push_back(static_cast<uint16_t>(i + 1));
+        indices.push_back(static_cast<uint16_t>(i + 2));
+    }
+    stroke.mesh = new AxmolGpuMesh(stroke.id, rive::Span<const rive::Vec2D>(strip.data(), strip.size()),
+                                   rive::Span<const uint16_t>(indices.data(), indices.size()));
+    return stroke.mesh;
+}
+
+// Adds the lifetime of the scope to 'seconds', does nothing when disabled
+class AxmolStatTimer {
+public:
+    AxmolStatTimer(bool enabled, double& seconds) : _seconds(enabled ? &seconds : nullptr) {
+        if (_seconds) _start = std::chrono::steady_clock::now();
+    }
+    ~AxmolStatTimer() {
+        if (_seconds) {
+            *_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - _start).count();
+        }
+    }
+
+private:
+    double* _seconds;
+    std::chrono::steady_clock::time_point _start;
+};
 
 // AxmolRenderer Implementation
-AxmolRenderer::AxmolRenderer(ax::Node* rootNode) : _rootNode(rootNode) {
-    _containerStack.push(_rootNode);
-    updateDrawNode();
+AxmolRenderer::AxmolRenderer(ax::Node* rootNode) {
+    // Clips go through the stencil of this node, so it is the only node we ever need
+    auto meshNode = AxmolMeshNode::create();
+    rootNode->addChild(meshNode);
+    _sink = meshNode;
+    clearCullRect();
+}
+
+AxmolRenderer::AxmolRenderer(AxmolRenderSink* sink) : _sink(sink) {
+    clearCullRect();
 }
 
-void AxmolRenderer::updateDrawNode() {
-    _drawNode = ax::DrawNode::create();
-    _containerStack.top()->addChild(_drawNode);
+AxmolRenderer::~AxmolRenderer() {
+    popClipsTo(0);
 }
 
 void AxmolRenderer::startFrame() {
+    beginRecording();
+}
+
+void AxmolRenderer::endFrame() {
+    finishRecording();
+    submit();
+}
+
+void AxmolRenderer::beginRecording() {
     // Reset stacks
-    while (!_containerStack.empty()) _containerStack.pop();
-    _containerStack.push(_rootNode);
-    
     while (!_stateStack.empty()) _stateStack.pop();
+    _recording->entries.clear();
+    _recording->images.clear();
+    _recording->stats = AxmolRenderStats();
+    _recordClipDepth = 0;
+}
+
+void AxmolRenderer::finishRecording() {
+    {
+        AxmolStatTimer drawTimer(_statsEnabled, _recording->stats.drawSeconds);
+        tessellate();
+    }
+    _recording->cullRect = _cullRect;
+    _recordClipDepth = 0;
+    std::swap(_recording, _finished);
+}
+
+void AxmolRenderer::submit() {
+    popClipsTo(0);
+    // Buffers and commands of the mesh node are kept and reused
+    _sink->clear();
+    _sinkBlendMode = rive::BlendMode::srcOver;
+    
+    {
+        AxmolStatTimer drawTimer(_statsEnabled, _finished->stats.drawSeconds);
+        for (const auto& entry : _finished->entries) {
+            switch (entry.type) {
+                case AxmolDrawEntry::Type::clip:
+                    submitClip(entry);
+                    break;
+                case AxmolDrawEntry::Type::popClips:
+                    popClipsTo(entry.clipDepth);
+                    break;
+                case AxmolDrawEntry::Type::image:
+                    submitImage(entry);
+                    break;
+                default:
+                    submitDraw(entry);
+                    break;
+            }
+        }
+    }
     
-    _clipDepth = 0;
+    // Leave the stencil cleared for whatever renders after us
+    popClipsTo(0);
+    applyClips();
+    _finished->stats.drawCallCount = static_cast<uint32_t>(_sink->getDrawCallCount());
+}
+
+// The path and every path it contours through its sub paths
+static void collectTessKeys(const AxmolRenderPath* path, std::vector<const void*>& keys) {
+    keys.push_back(path);
+    for (const AxmolRenderPath* subPath : path->subPaths()) {
+        collectTessKeys(subPath, keys);
+    }
+}
+
+void AxmolRenderer::tessellate() {
+    auto& entries = _recording->entries;
+    AxmolStatTimer tessTimer(_statsEnabled, _recording->stats.tessellationSeconds);
     
-    // Clear Axmol scene graph
-    _rootNode->removeAllChildren();
+    // Group the dirty work by what it mutates: the contour lives on the path, containers contour
+    // their sub paths (which a clip and a shape often share), strokes extrude from the path into
+    // their paint. Entries touching anything of an existing job join it, jobs they bridge merge.
+    _tessJobs.clear();
+    _tessMerged.clear();
+    _tessLinks.assign(entries.size(), NoEntry);
+    _tessOwners.clear();
+    auto liveJob = [this](uint32_t job) {
+        while (_tessMerged[job] != job) job = _tessMerged[job];
+        return job;
+    };
+    for (uint32_t i = 0; i < entries.size(); ++i) {
+        const auto& entry = entries[i];
+        const bool isStroke = entry.type == AxmolDrawEntry::Type::stroke;
+        if (entry.type == AxmolDrawEntry::Type::popClips || entry.type == AxmolDrawEntry::Type::image) continue;
+        if (isStroke ? !entry.paint->needsStroke(entry.path, entry.matrix) : !entry.path->needsGeometry(entry.matrix)) {
+            continue;
+        }
+
+        _tessKeys.clear();
+        collectTessKeys(entry.path, _tessKeys);
+        if (isStroke) _tessKeys.push_back(entry.paint);
+
+        uint32_t job = NoEntry;
+        for (const void* key : _tessKeys) {
+            auto owner = _tessOwners.find(key);
+            if (owner == _tessOwners.end()) continue;
+            uint32_t other = liveJob(owner->second);
+            if (job == NoEntry) {
+                job = other;
+            } else if (other != job) {
+                _tessLinks[_tessJobs[job].last] = _tessJobs[other].first;
+                _tessJobs[job].last = _tessJobs[other].last;
+                _tessJobs[other].first = NoEntry;
+                _tessMerged[other] = job;
+            }
+        }
+        if (job == NoEntry) {
+            job = static_cast<uint32_t>(_tessJobs.size());
+            _tessJobs.push_back({i, i});
+            _tessMerged.push_back(job);
+        } else {
+            _tessLinks[_tessJobs[job].last] = i;
+            _tessJobs[job].last = i;
+        }
+        for (const void* key : _tessKeys) {
+            _tessOwners[key] = job;
+        }
+    }
+    _tessJobs.erase(std::remove_if(_tessJobs.begin(), _tessJobs.end(),
+                                   [](const TessJob& job) { return job.first == NoEntry; }),
+                    _tessJobs.end());
+    _recording->stats.tessellationJobCount += static_cast<uint32_t>(_tessJobs.size());
     
-    // Create initial DrawNode
-    updateDrawNode();
+    // Only CPU geometry is touched here, meshes are created and uploaded on this thread when submitted
+    auto run = [this, &entries](size_t begin, size_t end) {
+        for (size_t j = begin; j < end; ++j) {
+            for (uint32_t i = _tessJobs[j].first; i != NoEntry; i = _tessLinks[i]) {
+                const auto& entry = entries[i];
+                if (entry.type == AxmolDrawEntry::Type::stroke) {
+                    entry.paint->updateStroke(entry.path, entry.matrix);
+                } else {
+                    entry.path->updateGeometry(entry.matrix);
+                }
+            }
+        }
+    };
+    if (_parallelTessellation) {
+        AxmolJobs::shared().parallelFor(_tessJobs.size(), 1, run);
+    } else {
+        run(0, _tessJobs.size());
+    }
+}
+
+void AxmolRenderer::popClipsTo(size_t depth) {
+    while (_clipStack.size() > depth) {
+        AX_SAFE_RELEASE(_clipStack.back().mesh);
+        _clipStack.pop_back();
+        _visibleStack.pop_back();
+        _clipsDirty = true;
+    }
+}
+
+void AxmolRenderer::setCullRect(const rive::AABB& rect) {
+    _cullRect = rect;
+}
+
+void AxmolRenderer::clearCullRect() {
+    const float inf = std::numeric_limits<float>::infinity();
+    _cullRect = rive::AABB(-inf, -inf, inf, inf);
+}
+
+rive::AABB AxmolRenderer::visibleRect() const {
+    return _visibleStack.empty() ? _finished->cullRect : _visibleStack.back();
+}
+
+rive::AABB AxmolRenderer::transformBounds(const rive::AABB& local, const rive::Mat2D& m) {
+    rive::Vec2D corners[4] = {
+        m * rive::Vec2D(local.minX, local.minY),
+        m * rive::Vec2D(local.maxX, local.minY),
+        m * rive::Vec2D(local.maxX, local.maxY),
+        m * rive::Vec2D(local.minX, local.maxY),
+    };
+    rive::AABB out(corners[0].x, corners[0].y, corners[0].x, corners[0].y);
+    for (const auto& p : corners) {
+        out.minX = std::min(out.minX, p.x);
+        out.minY = std::min(out.minY, p.y);
+        out.maxX = std::max(out.maxX, p.x);
+        out.maxY = std::max(out.maxY, p.y);
+    }
+    return out;
+}
+
+bool AxmolRenderer::isCulled(const rive::AABB& local, const rive::Mat2D& m, const rive::AABB& visible) const {
+    rive::AABB screen = transformBounds(local, m);
+    if (visible.minX >= visible.maxX || visible.minY >= visible.maxY) {
+        return true; // Inside a clip that is itself culled
+    }
+    // Touching an edge covers no pixel center
+    if (screen.maxX <= visible.minX || screen.minX >= visible.maxX || screen.maxY <= visible.minY ||
+        screen.minY >= visible.maxY) {
+        return true;
+    }
+    // The bounds area is an upper bound of what the path covers
+    return (screen.maxX - screen.minX) * (screen.maxY - screen.minY) < _minCoverage;
+}
+
+void AxmolRenderer::applyClips() {
+    if (!_clipsDirty) return;
+    _clipsDirty = false;
+    _sink->setClips(_clipStack);
+}
+
+void AxmolRenderer::applyBlendMode(rive::BlendMode mode) {
+    if (mode == _sinkBlendMode) return;
+    _sinkBlendMode = mode;
+    _sink->setBlendMode(mode);
 }
 
 void AxmolRenderer::save() {
     rive::TessRenderer::save();
-    _stateStack.push({_clipDepth});
+    _stateStack.push({_recordClipDepth});
 }
 
 void AxmolRenderer::restore() {
     rive::TessRenderer::restore();
-    if (!_stateStack.empty()) {
-        auto state = _stateStack.top();
-        _stateStack.pop();
-        
-        // Pop clippings
-        while (_clipDepth > state.clipDepth) {
-            if (!_containerStack.empty()) {
-                _containerStack.pop();
-            }
-            _clipDepth--;
-        }
-        
-        // Create new DrawNode in the current container (which might be a parent ClippingNode or Root)
-        updateDrawNode();
+    if (_stateStack.empty()) return;
+    
+    size_t depth = _stateStack.top().clipDepth;
+    _stateStack.pop();
+    if (depth < _recordClipDepth) {
+        AxmolDrawEntry entry;
+        entry.type = AxmolDrawEntry::Type::popClips;
+        entry.clipDepth = static_cast<uint32_t>(depth);
+        _recording->entries.push_back(std::move(entry));
+        _recordClipDepth = depth;
     }
 }
 
 void AxmolRenderer::clipPath(rive::RenderPath* path) {
     rive::TessRenderer::clipPath(path);
+    AxmolStatTimer drawTimer(_statsEnabled, _recording->stats.drawSeconds);
+    ++_recording->stats.clipPathCount;
     
-    // Create Stencil
-    auto stencil = ax::DrawNode::create();
-    
-    // Draw path into stencil
-    // Reuse logic from drawPath but for stencil (Fill only)
+    AxmolDrawEntry entry;
+    entry.type = AxmolDrawEntry::Type::clip;
+    entry.clipDepth = static_cast<uint32_t>(_recordClipDepth);
+    entry.path = static_cast<AxmolRenderPath*>(path);
+    entry.matrix = transform();
+    _recording->entries.push_back(std::move(entry));
+    ++_recordClipDepth;
+}
+
+void AxmolRenderer::drawPath(rive::RenderPath* path, rive::RenderPaint* paint) {
     auto axPath = static_cast<AxmolRenderPath*>(path);
-    axPath->contour(transform());
-    axPath->triangulate(); // Ensure updated
+    auto axPaint = static_cast<AxmolRenderPaint*>(paint);
+    AxmolStatTimer drawTimer(_statsEnabled, _recording->stats.drawSeconds);
+    ++_recording->stats.drawPathCount;
     
     const auto& m = transform();
-    for (size_t i = 0; i < axPath->_rawIndices.size(); i += 3) {
-        if (i + 2 >= axPath->_rawIndices.size()) break;
-        unsigned short i1 = axPath->_rawIndices[i];
-        unsigned short i2 = axPath->_rawIndices[i+1];
-        unsigned short i3 = axPath->_rawIndices[i+2];
-        
-        rive::Vec2D v1 = m * axPath->_rawVertices[i1];
-        rive::Vec2D v2 = m * axPath->_rawVertices[i2];
-        rive::Vec2D v3 = m * axPath->_rawVertices[i3];
-        
-        stencil->drawTriangle(
-            ax::Vec2(v1.x, v1.y),
-            ax::Vec2(v2.x, v2.y),
-            ax::Vec2(v3.x, v3.y),
-            ax::Color::GREEN // Color doesn't matter for stencil, alpha must be > 0
-        );
+    const bool isStroke = axPaint->_style == rive::RenderPaintStyle::stroke;
+    
+    // Cached bounds already tell when a path misses the cull rect, it then gets no tessellation
+    // job. Clips aren't pushed until submitted, culling against them happens there.
+    rive::AABB bounds;
+    bool hasBounds = isStroke ? axPaint->strokeBounds(axPath, bounds) : axPath->localBounds(bounds);
+    if (hasBounds && isCulled(bounds, m, _cullRect)) {
+        ++_recording->stats.culledCount;
+        return;
     }
     
-    // Create ClippingNode
-    auto clipper = ax::ClippingNode::create(stencil);
-    clipper->setAlphaThreshold(0.0f); // Default is 1, usually we want 0 or small
+    AxmolDrawEntry entry;
+    entry.type = isStroke ? AxmolDrawEntry::Type::stroke : AxmolDrawEntry::Type::fill;
+    entry.clipDepth = static_cast<uint32_t>(_recordClipDepth);
+    entry.path = axPath;
+    entry.paint = axPaint;
+    entry.matrix = m;
+    entry.color = axPaint->_color;
+    entry.shader = axPaint->_shader;
+    entry.blendMode = axPaint->_blendMode;
+    _recording->entries.push_back(std::move(entry));
+}
+
+void AxmolRenderer::drawImage(const rive::RenderImage* image, rive::ImageSampler, rive::BlendMode blendMode,
+                              float opacity) {
+    if (!image || opacity <= 0.0f) return;
+    AxmolStatTimer drawTimer(_statsEnabled, _recording->stats.drawSeconds);
+    ++_recording->stats.drawImageCount;
     
-    _containerStack.top()->addChild(clipper);
-    _containerStack.push(clipper);
-    _clipDepth++;
+    // Drawn over its own rect, the only bounds known without reading geometry
+    const auto& m = transform();
+    rive::AABB bounds(0.0f, 0.0f, static_cast<float>(image->width()), static_cast<float>(image->height()));
+    if (isCulled(bounds, m, _cullRect)) {
+        ++_recording->stats.culledCount;
+        return;
+    }
+    
+    AxmolImageDraw draw;
+    draw.image = static_cast<const AxmolRenderImage*>(image);
+    draw.opacity = opacity;
     
-    updateDrawNode();
+    AxmolDrawEntry entry;
+    entry.type = AxmolDrawEntry::Type::image;
+    entry.clipDepth = static_cast<uint32_t>(_recordClipDepth);
+    entry.blendMode = blendMode;
+    entry.matrix = m;
+    entry.index = static_cast<uint32_t>(_recording->images.size());
+    _recording->images.push_back(std::move(draw));
+    _recording->entries.push_back(std::move(entry));
 }
 
-void AxmolRenderer::drawPath(rive::RenderPath* path, rive::RenderPaint* paint) {
-    auto axPath = static_cast<AxmolRenderPath*>(path);
-    auto axPaint = static_cast<AxmolRenderPaint*>(paint);
+void AxmolRenderer::drawImageMesh(const rive::RenderImage* image, rive::ImageSampler,
+                                  rive::rcp<rive::RenderBuffer> vertices, rive::rcp<rive::RenderBuffer> uvs,
+                                  rive::rcp<rive::RenderBuffer> indices, uint32_t vertexCount, uint32_t indexCount,
+                                  rive::BlendMode blendMode, float opacity) {
+    if (!image || !vertices || !uvs || !indices || opacity <= 0.0f) return;
+    AxmolStatTimer drawTimer(_statsEnabled, _recording->stats.drawSeconds);
+    ++_recording->stats.drawImageCount;
+    
+    auto axVertices = static_cast<AxmolRenderBuffer*>(vertices.get());
+    auto axUVs = static_cast<AxmolRenderBuffer*>(uvs.get());
+    auto axIndices = static_cast<AxmolRenderBuffer*>(indices.get());
     
-    // Prepare color
-    ax::Color32 c;
-    bool hasShader = (axPaint->_shader != nullptr);
-    if (!hasShader) {
-        c = toAxColor(axPaint->_color);
+    // Counts past the end of a buffer are clamped instead of trusted, and indices are checked
+    // once here so the sinks can read the buffers as they are
+    size_t maxVertices = std::min(axVertices->sizeInBytes(), axUVs->sizeInBytes()) / sizeof(rive::Vec2D);
+    size_t count = std::min<size_t>(vertexCount, maxVertices);
+    size_t indexTotal = std::min<size_t>(indexCount, axIndices->sizeInBytes() / sizeof(uint16_t));
+    indexTotal -= indexTotal % 3;
+    auto indexData = reinterpret_cast<const uint16_t*>(axIndices->data());
+    if (count == 0 || indexTotal == 0 ||
+        *std::max_element(indexData, indexData + indexTotal) >= count) {
+        return;
     }
-    const auto& m = transform();
+    
+    AxmolImageDraw draw;
+    draw.image = static_cast<const AxmolRenderImage*>(image);
+    draw.vertices = {reinterpret_cast<const rive::Vec2D*>(axVertices->data()), count};
+    draw.uvs = {reinterpret_cast<const rive::Vec2D*>(axUVs->data()), count};
+    draw.indices = {indexData, indexTotal};
+    draw.buffers[0] = rive::static_rcp_cast<AxmolRenderBuffer>(std::move(vertices));
+    draw.buffers[1] = rive::static_rcp_cast<AxmolRenderBuffer>(std::move(uvs));
+    draw.buffers[2] = rive::static_rcp_cast<AxmolRenderBuffer>(std::move(indices));
+    draw.opacity = opacity;
+    
+    AxmolDrawEntry entry;
+    entry.type = AxmolDrawEntry::Type::image;
+    entry.clipDepth = static_cast<uint32_t>(_recordClipDepth);
+    entry.blendMode = blendMode;
+    entry.matrix = transform();
+    entry.index = static_cast<uint32_t>(_recording->images.size());
+    _recording->images.push_back(std::move(draw));
+    _recording->entries.push_back(std::move(entry));
+}
 
-    if (axPaint->_style == rive::RenderPaintStyle::stroke) {
-        // Stroke Logic
-        // We don't use _rawVertices for strokes, we use the _stroke helper directly.
-        static rive::Mat2D identity; // Stroke generation happens in local space too usually?
-        // Wait, TessRenderPath::extrudeStroke takes a transform.
-        // If we pass 'm' (world transform), the vertices in _stroke are World Space.
-        // If we pass identity, they are Local.
-        // Rive usually extrudes in Local space for better quality? Or World?
-        // TessRenderPath::extrudeStroke documentation says: "transform is the transform to apply to the path before stroking".
-        // If we want consistent stroke width in screen pixels, we usually pass the full transform.
-        // But if stroke is scaling, maybe we want that.
-        // For now, let's pass 'm' and assume _stroke vertices are World Space.
+void AxmolRenderer::submitClip(const AxmolDrawEntry& entry) {
+    auto& stats = _finished->stats;
+    const auto& m = entry.matrix;
+    auto axPath = entry.path;
+    AxmolClip clip;
+    clip.matrix = m;
+    
+    // A clip outside what is still visible hides everything under it. It is pushed without
+    // geometry (clips everything) and draws under it are culled, so it never reaches the sink.
+    rive::AABB bounds;
+    bool outside = axPath->localBounds(bounds) && isCulled(bounds, m, visibleRect());
+    if (!outside) {
+        // Only the stencil is written, the fill rule is already resolved by the triangulation.
+        // Retriangulates only when the path or the transform's scale changed since the last use.
+        {
+            AxmolStatTimer tessTimer(_statsEnabled, stats.tessellationSeconds);
+            axPath->updateGeometry(m);
+        }
+        outside = !axPath->localBounds(bounds) || isCulled(bounds, m, visibleRect());
+    }
+    
+    rive::AABB visible = visibleRect();
+    if (outside) {
+        ++stats.culledCount;
+        visible = rive::AABB(0.0f, 0.0f, 0.0f, 0.0f);
+    } else {
+        clip.mesh = axPath->gpuMesh();
+        AX_SAFE_RETAIN(clip.mesh);
+        if (clip.mesh) stats.triangleCount += clip.mesh->indexCount() / 3;
+        if (clip.mesh && axPath->shape() != AxmolRenderPath::Shape::general) ++stats.fastPathCount;
         
-        _stroke.reset();
-        axPath->extrudeStroke(&_stroke, axPaint->_join, axPaint->_cap, axPaint->_thickness, m);
+        rive::AABB screen = transformBounds(bounds, m);
+        visible = rive::AABB(std::max(visible.minX, screen.minX), std::max(visible.minY, screen.minY),
+                             std::min(visible.maxX, screen.maxX), std::min(visible.maxY, screen.maxY));
+    }
+    
+    _clipStack.push_back(clip);
+    _visibleStack.push_back(visible);
+    _clipsDirty = true;
+}
+
+void AxmolRenderer::submitDraw(const AxmolDrawEntry& entry) {
+    auto& stats = _finished->stats;
+    auto axPath = entry.path;
+    auto axPaint = entry.paint;
+    auto drawNode = _sink;
+    
+    // Applied on the GPU, vertices stay in local space
+    const auto& m = entry.matrix;
+    const bool isStroke = entry.type == AxmolDrawEntry::Type::stroke;
+    
+    // Bounds of the cached geometry are good enough to cull before any vertex work,
+    // otherwise we find out after tessellating
+    rive::AABB bounds;
+    bool hasBounds = isStroke ? axPaint->strokeBounds(axPath, bounds) : axPath->localBounds(bounds);
+    if (hasBounds && isCulled(bounds, m, visibleRect())) {
+        ++stats.culledCount;
+        return;
+    }
+    
+    // Prepare color. Gradients are evaluated in the fragment shader, the CPU
+    // per-vertex path is only a fallback for stop counts the shader can't hold.
+    ax::Color32 c = ax::Color32::WHITE;
+    const AxmolRenderShader* shader = entry.shader.get();
+    AxmolGradientUniforms gradient;
+    const AxmolGradientUniforms* gpuGradient = nullptr;
+    if (!shader) {
+        c = toAxColor(entry.color);
+    } else if (shader->gradientUniforms(gradient)) {
+        gpuGradient = &gradient;
+        shader = nullptr;
+    }
+
+    if (isStroke) {
+        // Stroke Logic
+        // The paint keeps the extruded strip of each path it strokes (local space, like the
+        // fill) until the path, the stroke style or the transform's scale change. Normally
+        // already extruded by tessellate().
+        {
+            AxmolStatTimer tessTimer(_statsEnabled, stats.tessellationSeconds);
+            axPaint->updateStroke(axPath, m);
+        }
         
-        const auto& strip = _stroke.triangleStrip();
-        if (strip.size() >= 3) {
-            for (size_t i = 0; i < strip.size() - 2; ++i) {
-                const auto& v1 = strip[i];
-                const auto& v2 = strip[i+1];
-                const auto& v3 = strip[i+2];
-                
-                // v1, v2, v3 are already transformed (if extrudeStroke used 'm')
-                
-                if (hasShader) {
-                    ax::Color colors[3];
-                    colors[0] = ax::Color(axPaint->_shader->getColor(v1.x, v1.y));
-                    colors[1] = ax::Color(axPaint->_shader->getColor(v2.x, v2.y));
-                    colors[2] = ax::Color(axPaint->_shader->getColor(v3.x, v3.y));
-                    
-                    ax::Vec2 verts[3] = {
-                        ax::Vec2(v1.x, v1.y),
-                        ax::Vec2(v2.x, v2.y),
-                        ax::Vec2(v3.x, v3.y)
-                    };
-                    _drawNode->drawColoredTriangle(verts, colors);
-                } else {
-                    _drawNode->drawTriangle(
-                        ax::Vec2(v1.x, v1.y),
-                        ax::Vec2(v2.x, v2.y),
-                        ax::Vec2(v3.x, v3.y),
-                        c
-                    );
-                }
-            }
+        const auto& strip = axPaint->strokeStrip(axPath);
+        if (strip.size() < 3) {
+            return;
+        }
+        if (!hasBounds && axPaint->strokeBounds(axPath, bounds) && isCulled(bounds, m, visibleRect())) {
+            ++stats.culledCount;
+            return;
+        }
+        applyClips();
+        applyBlendMode(entry.blendMode);
+        stats.triangleCount += strip.size() - 2;
+        rive::Span<const rive::Vec2D> stripSpan(strip.data(), strip.size());
+        AxmolGpuMesh* strokeMesh = shader ? nullptr : axPaint->strokeMesh(axPath);
+        if (strokeMesh) {
+            // Uploaded once per extrusion, like fills
+            drawNode->drawMesh(strokeMesh, m, c, gpuGradient);
+        } else if (shader) {
+            drawNode->drawStrip(stripSpan, m, shader);
+        } else {
+            drawNode->drawStrip(stripSpan, m, c, gpuGradient);
         }
     } else {
         // Fill Logic
-        // Update cache if needed
-        axPath->contour(transform()); // Ensure contour is updated
-        
-        size_t oldV = axPath->_rawVertices.size();
-        size_t oldI = axPath->_rawIndices.size();
-        
-        bool changed = axPath->triangulate(); 
-        
-        if (changed) {
-            // Prune old geometry, keep new
-            axPath->prune(oldV, oldI);
+        // No-op after tessellate() unless the path is drawn with several scales
+        {
+            AxmolStatTimer tessTimer(_statsEnabled, stats.tessellationSeconds);
+            axPath->updateGeometry(m);
         }
         
-        // Iterate and draw, applying transform 'm'
-        if (axPath->_rawVertices.empty() || axPath->_rawIndices.empty()) {
+        auto vertices = axPath->vertices();
+        auto indices = axPath->indices();
+        if (vertices.empty() || indices.empty()) {
+            return;
+        }
+        if (!hasBounds && axPath->localBounds(bounds) && isCulled(bounds, m, visibleRect())) {
+            ++stats.culledCount;
             return;
         }
+        applyClips();
+        applyBlendMode(entry.blendMode);
+        stats.triangleCount += indices.size() / 3;
+        if (axPath->shape() != AxmolRenderPath::Shape::general) ++stats.fastPathCount;
         
-        for (size_t i = 0; i < axPath->_rawIndices.size(); i += 3) {
-            if (i + 2 >= axPath->_rawIndices.size()) break;
-            
-            unsigned short i1 = axPath->_rawIndices[i];
-            unsigned short i2 = axPath->_rawIndices[i+1];
-            unsigned short i3 = axPath->_rawIndices[i+2];
-            
-            // Transform on the fly!
-            rive::Vec2D v1 = m * axPath->_rawVertices[i1];
-            rive::Vec2D v2 = m * axPath->_rawVertices[i2];
-            rive::Vec2D v3 = m * axPath->_rawVertices[i3];
-            
-            if (hasShader) {
-                // Per-vertex coloring for smooth gradients
-                ax::Color colors[3];
-                colors[0] = ax::Color(axPaint->_shader->getColor(v1.x, v1.y));
-                colors[1] = ax::Color(axPaint->_shader->getColor(v2.x, v2.y));
-                colors[2] = ax::Color(axPaint->_shader->getColor(v3.x, v3.y));
-                
-                ax::Vec2 verts[3] = {
-                    ax::Vec2(v1.x, v1.y),
-                    ax::Vec2(v2.x, v2.y),
-                    ax::Vec2(v3.x, v3.y)
-                };
-                
-                _drawNode->drawColoredTriangle(verts, colors);
-            } else {
-                _drawNode->drawTriangle(
-                    ax::Vec2(v1.x, v1.y),
-                    ax::Vec2(v2.x, v2.y),
-                    ax::Vec2(v3.x, v3.y),
-                    c
-                );
-            }
+        if (shader) {
+            // Per-vertex coloring fallback
+            drawNode->drawTriangles(vertices, indices, m, shader);
+        } else {
+            // Uploaded once per triangulation, only the matrix changes per frame
+            drawNode->drawMesh(axPath->gpuMesh(), m, c, gpuGradient);
         }
     }
 }
 
+void AxmolRenderer::submitImage(const AxmolDrawEntry& entry) {
+    auto& stats = _finished->stats;
+    const auto& draw = _finished->images[entry.index];
+    const auto& m = entry.matrix;
+    auto image = draw.image;
+    
+    // A plain drawImage is the image's rect with its full uv range
+    static const rive::Vec2D quadUVs[4] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+    static const uint16_t quadIndices[6] = {0, 1, 2, 0, 2, 3};
+    const float w = static_cast<float>(image->width());
+    const float h = static_cast<float>(image->height());
+    const rive::Vec2D quad[4] = {{0.0f, 0.0f}, {w, 0.0f}, {w, h}, {0.0f, h}};
+    
+    auto vertices = draw.vertices;
+    auto uvs = draw.uvs;
+    auto indices = draw.indices;
+    if (!draw.buffers[0]) {
+        vertices = {quad, 4};
+        uvs = {quadUVs, 4};
+        indices = {quadIndices, 6};
+    }
+    
+    rive::AABB bounds(vertices[0].x, vertices[0].y, vertices[0].x, vertices[0].y);
+    for (const auto& v : vertices) {
+        bounds.minX = std::min(bounds.minX, v.x);
+        bounds.minY = std::min(bounds.minY, v.y);
+        bounds.maxX = std::max(bounds.maxX, v.x);
+        bounds.maxY = std::max(bounds.maxY, v.y);
+    }
+    if (isCulled(bounds, m, visibleRect())) {
+        ++stats.culledCount;
+        return;
+    }
+    applyClips();
+    applyBlendMode(entry.blendMode);
+    stats.triangleCount += indices.size() / 3;
+    _sink->drawImage(image, vertices, uvs, indices, m, draw.opacity);
+}
+
+// Packs the embedded images of one import into an atlas, out of band assets are left to Rive
+class AxmolImageAssetLoader : public rive::FileAssetLoader {
+public:
+    bool loadContents(rive::FileAsset& asset, rive::Span<const uint8_t> inBandBytes, rive::Factory*) override {
+        if (!asset.is<rive::ImageAsset>() || inBandBytes.empty()) return false;
+        auto image = _atlas.decode(inBandBytes);
+        if (!image) return false;
+        asset.as<rive::ImageAsset>()->renderImage(std::move(image));
+        return true;
+    }
+
+private:
+    AxmolImageAtlas _atlas;
+};
+
+// AxmolRenderBuffer Implementation
+AxmolRenderBuffer::AxmolRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags, size_t sizeInBytes)
+    : rive::RenderBuffer(type, flags, sizeInBytes) {
+    _copies[0].resize(sizeInBytes);
+}
+
+void* AxmolRenderBuffer::onMap() {
+    // The first map fills the only copy. From the second one on the buffer is dynamic.
+    if (_revision == 0) return _copies[0].data();
+    if (_copies[1].empty()) _copies[1].resize(sizeInBytes());
+    return _copies[_front ^ 1].data();
+}
+
+void AxmolRenderBuffer::onUnmap() {
+    if (_revision > 0) _front ^= 1;
+    ++_revision;
+}
+
 // AxmolFactory Implementation
-rive::rcp<rive::RenderBuffer> AxmolFactory::makeRenderBuffer(rive::RenderBufferType, rive::RenderBufferFlags, size_t sizeInBytes) {
-    return nullptr;
+rive::rcp<rive::RenderBuffer> AxmolFactory::makeRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags, size_t sizeInBytes) {
+    return rive::make_rcp<AxmolRenderBuffer>(type, flags, sizeInBytes);
 }
 
 rive::rcp<rive::RenderShader> AxmolFactory::makeLinearGradient(
@@ -385,6 +1242,12 @@ rive::rcp<rive::RenderPaint> AxmolFactory::makeRenderPaint() {
     return rive::make_rcp<AxmolRenderPaint>();
 }
 
-rive::rcp<rive::RenderImage> AxmolFactory::decodeImage(rive::Span<const uint8_t>) {
-    return nullptr;
+rive::rcp<rive::RenderImage> AxmolFactory::decodeImage(rive::Span<const uint8_t> bytes) {
+    AxmolImageAtlas atlas(false);
+    return atlas.decode(bytes);
+}
+
+rive::rcp<rive::File> AxmolFactory::importFile(rive::Span<const uint8_t> bytes, rive::ImportResult* result) {
+    // Per import, so concurrent imports never share an atlas
+    return rive::File::import(bytes, this, result, rive::make_rcp<AxmolImageAssetLoader>());
 }
@@ -6,42 +6,166 @@
 // Rive includes
 #include "rive/renderer.hpp"
 #include "rive/factory.hpp"
+#include "rive/file.hpp"
 #include "rive/tess/tess_renderer.hpp"
 #include "rive/tess/tess_render_path.hpp"
 #include "rive/tess/contour_stroke.hpp" // Added
 
+#include "AxmolMeshNode.h"
+#include "AxmolImageAtlas.h"
+
+#include <algorithm>
+#include <array>
+#include <unordered_map>
 #include <vector>
 
 namespace rive {
     class RawPath;
 }
 
+// Mesh data of drawImageMesh. Rive writes straight into the memory the sinks read (and
+// AxmolMeshNode uploads from), nothing is copied in between.
+//
+// Buffers Rive maps again after initialization (deformed vertices) are double-buffered: each map
+// writes the copy the last unmap didn't publish, so a recorded frame keeps reading its own
+// vertices while the next frame is being recorded, without a copy per frame. Rive rewrites the
+// whole buffer on every map, the other copy's contents never need to carry over.
+class AxmolRenderBuffer : public rive::RenderBuffer {
+public:
+    AxmolRenderBuffer(rive::RenderBufferType type, rive::RenderBufferFlags flags, size_t sizeInBytes);
+
+    // Contents of the last unmap
+    const uint8_t* data() const { return _copies[_front].data(); }
+    // Bumped by every unmap
+    uint32_t revision() const { return _revision; }
+
+protected:
+    void* onMap() override;
+    void onUnmap() override;
+
+private:
+    std::vector<uint8_t> _copies[2]; // The second one stays empty for buffers mapped only once
+    uint32_t _front = 0;
+    uint32_t _revision = 0;
+};
+
+// Render objects (paths, paints, shaders) can be created and used on any thread, each object by
+// one thread at a time: the one recording or tessellating it. Shaders are immutable once made and
+// can be shared freely. Resident meshes (gpuMesh, strokeMesh) are only made while submitting, so
+// objects that were ever submitted are destroyed on the submitting thread (the Axmol thread).
 class AxmolRenderPath : public rive::TessRenderPath {
 public:
+    // How the current triangulation was made. Single contours that never turn back are
+    // triangulated directly, only the others go through the general tessellator.
+    enum class Shape : uint8_t {
+        general, // Tessellated (concave, self-intersecting or several contours)
+        convex,  // Zigzag strip over the contour (rounded rects, ellipses, ...)
+        rect,    // Axis-aligned rectangle, two triangles
+    };
+
     AxmolRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule);
-    ~AxmolRenderPath() override = default;
+    ~AxmolRenderPath() override;
 
-    // Called by TessRenderPath::triangulate
+    // Called by TessRenderPath::triangulate, collects the new triangulation apart from the current one
     void addTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices) override;
     void setTriangulatedBounds(const rive::AABB& value) override;
     
     void rewind() override; // Override rewind to clear cache
-    
-    // Clears old geometry and shifts new geometry to front
-    void prune(size_t oldVertexCount, size_t oldIndexCount);
+    // Records the sub paths, triangulating or stroking this path contours them too
+    void addRenderPath(rive::RenderPath* path, const rive::Mat2D& transform) override;
+
+    // Contours and triangulates for the transform if needed, returns true when the cached geometry changed.
+    // Skipped entirely while the path is unchanged and the transform has the same scale/rotation.
+    bool updateGeometry(const rive::Mat2D& transform);
+    // True when updateGeometry would retriangulate for this transform
+    bool needsGeometry(const rive::Mat2D& transform) const;
+    Shape shape() const { return _shape; }
+
+    // Process-wide, set before drawing. Fast paths are on by default, turn them off to compare
+    // against the tessellator.
+    static void setFastPaths(bool enabled);
+    // Also tessellates every fast path shape and compares the coverage (area and bounds) of both
+    // triangulations, mismatches are logged and counted. Costs the tessellation it saves.
+    static void setFastPathValidation(bool enabled);
+    static uint64_t getFastPathMismatchCount();
+
+    // Unique per triangulation, changes whenever vertices()/indices() do
+    uint64_t geometryId() const { return _geometryId; }
+    // Unique per path content, only changes on rewind (strokes key on this, not on the fill triangulation)
+    uint64_t pathRevision() const { return _pathRevision; }
+
+    // GPU copy of the current triangulation, uploaded on first use after each change
+    AxmolGpuMesh* gpuMesh();
+
+    // Local bounds of the last triangulation, false when the path changed since (or never was triangulated)
+    bool localBounds(rive::AABB& out) const;
+
+    // Paths added with addRenderPath since the last rewind
+    const std::vector<AxmolRenderPath*>& subPaths() const { return _subPaths; }
+
+    // Current triangulation, local untransformed vertices
+    rive::Span<const rive::Vec2D> vertices() const { return {_rawVertices.data(), _rawVertices.size()}; }
+    rive::Span<const uint16_t> indices() const { return {_rawIndices.data(), _rawIndices.size()}; }
 
     // Friend to allow renderer to call protected contour()
     friend class AxmolRenderer;
+    friend class AxmolRenderPaint;
 
-    // Local untransformed vertices (Cached for Fills)
+private:
+    void bumpGeometryId();
+    // Triangulates the contour into _newVertices/_newIndices when it has a fast path, leaves
+    // them empty otherwise
+    Shape triangulateFast();
+    void validateFastPath(Shape shape);
+
+    // Current triangulation, and the one triangulate() is writing. Swapped when it finishes,
+    // both keep their capacity across triangulations.
     std::vector<rive::Vec2D> _rawVertices;
     std::vector<uint16_t> _rawIndices;
+    std::vector<rive::Vec2D> _newVertices;
+    std::vector<uint16_t> _newIndices;
+
+    std::vector<AxmolRenderPath*> _subPaths; // Not retained, TessRenderPath keeps them as raw pointers too
+
+    uint64_t _geometryId = 0;
+    uint64_t _pathRevision = 0;
+    AxmolGpuMesh* _gpuMesh = nullptr;
+    Shape _shape = Shape::general;
+
+    // Key of the current triangulation: the geometry it produced and the linear part of its transform.
+    // Vertices are local, so the translation never matters.
+    uint64_t _triangulatedId = 0;
+    float _triangulatedLinear[4] = {};
+
+    rive::AABB _bounds;
+    uint64_t _boundsRevision = 0; // _pathRevision the bounds were measured for
+    rive::AABB _newBounds;        // Of _newVertices, gathered while they are written
+};
+
+// Gradient colors baked at a fixed resolution, lookups are a clamp and an index
+class AxmolColorRamp {
+public:
+    static constexpr int Size = 256;
+
+    void bake(const rive::ColorInt colors[], const float stops[], size_t count);
+
+    ax::Color32 at(float t) const {
+        int i = static_cast<int>(t * (Size - 1) + 0.5f);
+        return _colors[std::max(0, std::min(Size - 1, i))];
+    }
+
+private:
+    std::array<ax::Color32, Size> _colors;
 };
 
 class AxmolRenderShader : public rive::RenderShader {
 public:
     virtual ~AxmolRenderShader() = default;
     virtual ax::Color32 getColor(float x, float y) const = 0;
+    // Colors a span of points into out[i].color, gradients override this with the batch kernels
+    virtual void getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const;
+    // Fills the rive_path fragment uniforms, false if the gradient can't be evaluated on the GPU
+    virtual bool gradientUniforms(AxmolGradientUniforms& out) const = 0;
 };
 
 class AxmolLinearGradient : public AxmolRenderShader {
@@ -50,14 +174,18 @@ public:
                         const rive::ColorInt colors[], const float stops[], size_t count);
     
     ax::Color32 getColor(float x, float y) const override;
+    void getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const override;
+    bool gradientUniforms(AxmolGradientUniforms& out) const override;
     
 private:
     rive::Vec2D _start;
     rive::Vec2D _end;
     rive::Vec2D _diff; // end - start
     float _lenSq;
+    float _invLenSq;
     std::vector<rive::ColorInt> _colors;
     std::vector<float> _stops;
+    AxmolColorRamp _ramp;
 };
 
 class AxmolRadialGradient : public AxmolRenderShader {
@@ -66,17 +194,30 @@ public:
                         const rive::ColorInt colors[], const float stops[], size_t count);
     
     ax::Color32 getColor(float x, float y) const override;
+    void getColors(rive::Span<const rive::Vec2D> points, AxmolMeshVertex* out) const override;
+    bool gradientUniforms(AxmolGradientUniforms& out) const override;
 
 private:
     rive::Vec2D _center;
     float _radius;
+    float _invRadius;
+    // Squared distances where the ramp is known to be constant, avoids the sqrt outside [first, last] stop
+    float _innerDistSq;
+    float _outerDistSq;
     std::vector<rive::ColorInt> _colors;
     std::vector<float> _stops;
+    AxmolColorRamp _ramp;
 };
 
 class AxmolRenderPaint : public rive::RenderPaint {
 public:
+    // Scale change (either way) after which a cached stroke is extruded again for the new tolerance
+    static constexpr float StrokeRescale = 1.1f;
+    // Paths whose strokes a paint keeps, the least recently stroked one is dropped past this
+    static constexpr size_t MaxCachedStrokes = 16;
+
     AxmolRenderPaint();
+    ~AxmolRenderPaint() override;
     
     void style(rive::RenderPaintStyle style) override;
     void color(rive::ColorInt value) override;
@@ -87,6 +228,20 @@ public:
     void shader(rive::rcp<rive::RenderShader>) override;
     void invalidateStroke() override;
 
+    // Extrudes 'path' with this paint's stroke into a local space strip, cached per path since a
+    // paint can stroke several. Reused until the path is rewound, the stroke style changes or the
+    // transform's scale moves past StrokeRescale. Returns true when it had to extrude again.
+    bool updateStroke(AxmolRenderPath* path, const rive::Mat2D& transform);
+    // True when updateStroke would extrude again
+    bool needsStroke(const AxmolRenderPath* path, const rive::Mat2D& transform) const;
+    // Strip of 'path' from its last updateStroke, empty when it has none
+    const std::vector<rive::Vec2D>& strokeStrip(const AxmolRenderPath* path) const;
+    // Resident copy of the strip of 'path', null when empty or too long for 16-bit indices.
+    // Submitting thread only.
+    AxmolGpuMesh* strokeMesh(const AxmolRenderPath* path);
+    // Local bounds of the strip, false unless 'path' has a current stroke
+    bool strokeBounds(const AxmolRenderPath* path, rive::AABB& out) const;
+
     rive::RenderPaintStyle _style = rive::RenderPaintStyle::fill;
     rive::ColorInt _color = 0xFFFFFFFF;
     float _thickness = 1.0f;
@@ -94,6 +249,28 @@ public:
     rive::StrokeCap _cap = rive::StrokeCap::butt;
     rive::BlendMode _blendMode = rive::BlendMode::srcOver;
     rive::rcp<AxmolRenderShader> _shader; // Store the shader
+
+private:
+    struct Stroke {
+        rive::ContourStroke contour;
+        uint64_t pathRevision = 0;
+        uint64_t styleRevision = 0;
+        float scale = 0.0f;
+        uint64_t id = 0;      // Geometry id of the strip
+        uint64_t lastUse = 0; // _useClock when last stroked
+        rive::AABB bounds;
+        AxmolGpuMesh* mesh = nullptr;
+    };
+
+    // Stroke of 'path' for its current revision and this paint's style, null when there is none
+    const Stroke* currentStroke(const AxmolRenderPath* path) const;
+
+    // Paths are only compared, paired with their revision
+    std::unordered_map<const AxmolRenderPath*, Stroke> _strokes;
+    uint64_t _styleRevision = 1; // Bumped by any stroke style change
+    uint64_t _useClock = 0;
+    // Meshes of dropped strokes, released by strokeMesh on the submitting thread
+    std::vector<AxmolGpuMesh*> _retiredMeshes;
 };
 
 #include <stack>
@@ -101,12 +278,72 @@ public:
 // ... existing classes ...
 
 struct AxmolState {
-    int clipDepth = 0;
+    size_t clipDepth = 0;
+};
+
+// One recorded renderer call. Paths and paints are borrowed, the artboard keeps them alive
+// for the frame; the paint's color and shader are copied when recorded.
+struct AxmolDrawEntry {
+    enum class Type : uint8_t {
+        fill,
+        stroke,
+        clip,
+        popClips, // restore() back to 'clipDepth' clips
+        image,    // Frame::images['index']
+    };
+
+    Type type = Type::fill;
+    uint32_t clipDepth = 0; // Clips open when recorded, the target depth for popClips
+    AxmolRenderPath* path = nullptr;
+    AxmolRenderPaint* paint = nullptr;
+    rive::Mat2D matrix;
+    rive::ColorInt color = 0xFFFFFFFF;
+    rive::rcp<AxmolRenderShader> shader;
+    rive::BlendMode blendMode = rive::BlendMode::srcOver;
+    uint32_t index = 0;
+};
+
+// drawImage/drawImageMesh arguments, the image is borrowed like paths. The mesh points into
+// the buffers' copies current when recorded, which the retained buffers keep until the next
+// unmap after that. No mesh for a plain drawImage, which draws the image's own rect.
+struct AxmolImageDraw {
+    const AxmolRenderImage* image = nullptr;
+    rive::rcp<AxmolRenderBuffer> buffers[3]; // Vertices, uvs, indices
+    rive::Span<const rive::Vec2D> vertices;
+    rive::Span<const rive::Vec2D> uvs;
+    rive::Span<const uint16_t> indices;
+    float opacity = 1.0f;
+};
+
+// Per-frame counters of AxmolRenderer, reset by beginRecording. Only collected while enabled,
+// timing costs a few clock reads per draw.
+struct AxmolRenderStats {
+    uint32_t drawPathCount = 0;
+    uint32_t drawImageCount = 0;
+    uint32_t clipPathCount = 0;
+    uint32_t culledCount = 0;        // Draws and clips dropped by viewport, clip or coverage culling
+    uint32_t tessellationJobCount = 0; // Paths with dirty geometry tessellated on the job pool
+    uint32_t fastPathCount = 0;      // Fills and clips drawn from a convex or rect triangulation
+    uint64_t triangleCount = 0;      // Fill, stroke, image and clip triangles handed to the sink
+    uint32_t drawCallCount = 0;      // Commands the sink made of them, after batching
+    double tessellationSeconds = 0.0; // Contouring, triangulation and stroke extrusion (wall time)
+    double drawSeconds = 0.0;         // Recording, tessellation and submission
 };
 
+// Frames are built in two phases. drawPath/clipPath/restore only record into a flat draw list;
+// finishing the recording tessellates every dirty path of the list on the AxmolJobs pool, and
+// submit() sends the list in order to the sink, culling against the clips as they are pushed.
+//
+// Recording and submission use separate draw lists. Recording (advance, draw, finishRecording)
+// only touches Rive objects, so it can run on another thread (AxmolFramePipeline) while the
+// engine renders what was submitted last, as long as submit() doesn't overlap with it.
 class AxmolRenderer : public rive::TessRenderer {
 public:
+    // Renders into an AxmolMeshNode added to rootNode
     AxmolRenderer(ax::Node* rootNode);
+    // Renders into any sink (e.g. AxmolSoftwareSink when there is no GPU), not owned
+    AxmolRenderer(AxmolRenderSink* sink);
+    ~AxmolRenderer() override;
     
     void drawPath(rive::RenderPath* path, rive::RenderPaint* paint) override;
     void clipPath(rive::RenderPath* path) override;
@@ -116,25 +353,99 @@ public:
     // Stub implementations for pure virtuals in TessRenderer/Renderer
     void orthographicProjection(float left, float right, float bottom, float top, float near, float far) override {}
     
-    // Call at start of frame
+    // Call at start of frame, same as beginRecording
     void startFrame();
+    // Call at end of frame: finishRecording then submit
+    void endFrame();
+    
+    // Starts a new draw list, the renderer's drawing calls append to it
+    void beginRecording();
+    // Tessellates the recorded list and makes it the one submit() sends
+    void finishRecording();
+    // Sends the last finished list to the sink, then pops clips left open by unbalanced
+    // save/restore. Must run on the thread that owns the sink (the Axmol thread for AxmolMeshNode).
+    void submit();
     
-    // Images - Stub for now
-    void drawImage(const rive::RenderImage*, rive::ImageSampler, rive::BlendMode, float opacity) override {}
-    void drawImageMesh(const rive::RenderImage*, rive::ImageSampler, rive::rcp<rive::RenderBuffer>, rive::rcp<rive::RenderBuffer>, rive::rcp<rive::RenderBuffer>, uint32_t, uint32_t, rive::BlendMode, float) override {}
+    // Paths whose transformed bounds miss this rect (output space, e.g. the visible screen) are skipped
+    void setCullRect(const rive::AABB& rect);
+    void clearCullRect();
+    // Paths whose transformed bounds cover less than this area are skipped, in output units
+    // squared (pixels for AxmolSoftwareSink, design points for AxmolMeshNode). 0 disables it.
+    void setMinCoverage(float area) { _minCoverage = area; }
+    // Tessellate dirty paths on the worker pool (default) or serially on the calling thread
+    void setParallelTessellation(bool enabled) { _parallelTessellation = enabled; }
+    
+    void setStatsEnabled(bool enabled) { _statsEnabled = enabled; }
+    // Stats of the last finished frame
+    const AxmolRenderStats& getStats() const { return _finished->stats; }
+    
+    // Images come from an AxmolFactory, their atlas page is sampled with clamping whatever the
+    // sampler asks for
+    void drawImage(const rive::RenderImage* image, rive::ImageSampler, rive::BlendMode blendMode,
+                   float opacity) override;
+    void drawImageMesh(const rive::RenderImage* image, rive::ImageSampler, rive::rcp<rive::RenderBuffer> vertices,
+                       rive::rcp<rive::RenderBuffer> uvs, rive::rcp<rive::RenderBuffer> indices, uint32_t vertexCount,
+                       uint32_t indexCount, rive::BlendMode blendMode, float opacity) override;
 
 private:
-    ax::DrawNode* _drawNode = nullptr; // Current draw node
-    ax::Node* _rootNode = nullptr;
-    rive::ContourStroke _stroke;
+    // Dirty entries sharing a path, sub path or stroking paint, run in order by one job
+    struct TessJob {
+        uint32_t first = 0;
+        uint32_t last = 0;
+    };
+    static constexpr uint32_t NoEntry = 0xFFFFFFFF;
+    
+    struct Frame {
+        std::vector<AxmolDrawEntry> entries;
+        std::vector<AxmolImageDraw> images;
+        AxmolRenderStats stats;
+        rive::AABB cullRect; // Cull rect when the recording finished
+    };
+
+    AxmolRenderSink* _sink = nullptr; // The artboard's AxmolMeshNode unless given a sink
     
-    std::stack<ax::Node*> _containerStack;
     std::stack<AxmolState> _stateStack;
-    int _clipDepth = 0;
+    // Double-buffered draw lists, kept across frames for their capacity
+    Frame _frames[2];
+    Frame* _recording = &_frames[0];
+    Frame* _finished = &_frames[1];
+    size_t _recordClipDepth = 0;
+    
+    bool _parallelTessellation = true;
+    std::vector<TessJob> _tessJobs;
+    std::vector<uint32_t> _tessLinks; // Next entry of the same job, per draw list entry
+    std::unordered_map<const void*, uint32_t> _tessOwners; // Path, sub path or paint -> job
+    std::vector<uint32_t> _tessMerged; // Job each job was merged into, itself while it is live
+    std::vector<const void*> _tessKeys; // Scratch, what one entry touches
+    
+    // Clips pushed while submitting (meshes retained). Applied to the sink lazily on the next draw,
+    // so a restore followed by the same clipPath costs nothing.
+    std::vector<AxmolClip> _clipStack;
+    // Output space rect still visible inside each clip of _clipStack (cull rect included)
+    std::vector<rive::AABB> _visibleStack;
+    bool _clipsDirty = false;
+    // Blend mode last given to the sink, only set again when a draw needs another one
+    rive::BlendMode _sinkBlendMode = rive::BlendMode::srcOver;
     
-    void updateDrawNode();
+    rive::AABB _cullRect;
+    float _minCoverage = 0.0f;
+    
+    bool _statsEnabled = false;
+    
+    void tessellate();
+    void submitClip(const AxmolDrawEntry& entry);
+    void submitDraw(const AxmolDrawEntry& entry);
+    void submitImage(const AxmolDrawEntry& entry);
+    void applyClips();
+    void applyBlendMode(rive::BlendMode mode);
+    void popClipsTo(size_t depth);
+    rive::AABB visibleRect() const;
+    bool isCulled(const rive::AABB& local, const rive::Mat2D& m, const rive::AABB& visible) const;
+    static rive::AABB transformBounds(const rive::AABB& local, const rive::Mat2D& m);
 };
 
+// Holds no state, any number of threads can create render objects through one factory at once
+// (e.g. the AxmolRiveCache loader importing while the main thread plays another file).
 class AxmolFactory : public rive::Factory {
 public:
     rive::rcp<rive::RenderBuffer> makeRenderBuffer(rive::RenderBufferType, rive::RenderBufferFlags, size_t sizeInBytes) override;
@@ -150,7 +461,11 @@ public:
     rive::rcp<rive::RenderPath> makeRenderPath(rive::RawPath& rawPath, rive::FillRule fillRule) override;
     rive::rcp<rive::RenderPath> makeEmptyRenderPath() override;
     rive::rcp<rive::RenderPaint> makeRenderPaint() override;
-    rive::rcp<rive::RenderImage> decodeImage(rive::Span<const uint8_t>) override;
+    // One page of the padded image size per image, files imported with importFile share pages instead
+    rive::rcp<rive::RenderImage> decodeImage(rive::Span<const uint8_t> bytes) override;
+    
+    // rive::File::import with the embedded images of the file packed into shared atlas pages
+    rive::rcp<rive::File> importFile(rive::Span<const uint8_t> bytes, rive::ImportResult* result = nullptr);
 };
 
 #endif // _AXMOL_RIVE_H_
@@ -0,0 +1,300 @@
+#include "AxmolRiveCache.h"
+#include "AxmolFileMapping.h"
+
+#include <algorithm> // For std::min
+
+static AxmolRiveCache* s_sharedRiveCache = nullptr;
+
+AxmolRiveCache* AxmolRiveCache::getInstance() {
+    if (!s_sharedRiveCache) {
+        s_sharedRiveCache = new AxmolRiveCache();
+    }
+    return s_sharedRiveCache;
+}
+
+void AxmolRiveCache::destroyInstance() {
+    delete s_sharedRiveCache;
+    s_sharedRiveCache = nullptr;
+}
+
+AxmolRiveCache::~AxmolRiveCache() {
+    if (_loader.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(_loaderMutex);
+            for (auto& request : _loads) {
+                request->cancel();
+            }
+            _loaderQuit = true;
+        }
+        _loaderWake.notify_all();
+        _loader.join();
+    }
+}
+
+rive::rcp<rive::File> AxmolRiveCache::getFile(std::string_view path) {
+    std::string key(path);
+    auto it = _files.find(key);
+    if (it != _files.end()) {
+        return it->second;
+    }
+
+    auto fileUtils = ax::FileUtils::getInstance();
+    std::string fullPath = fileUtils->fullPathForFilename(key);
+    if (fullPath.empty()) {
+        AXLOGD("AxmolRiveCache: %s not found", key.c_str());
+        return nullptr;
+    }
+    // Straight from the mapping when the file is on disk, else from a heap copy
+    rive::rcp<rive::File> file;
+    rive::ImportResult result;
+    AxmolFileMapping mapping;
+    if (mapping.map(fullPath)) {
+        file = _factory.importFile(rive::Span<const uint8_t>(mapping.data(), mapping.size()), &result);
+    } else {
+        auto data = fileUtils->getDataFromFile(fullPath);
+        if (data.isNull()) {
+            AXLOGD("AxmolRiveCache: can't read %s", fullPath.c_str());
+            return nullptr;
+        }
+        file = _factory.importFile(rive::Span<const uint8_t>(data.getBytes(), data.getSize()), &result);
+    }
+    if (!file) {
+        AXLOGD("AxmolRiveCache: failed to import %s", fullPath.c_str());
+        return nullptr;
+    }
+    _files.emplace(std::move(key), file);
+    return file;
+}
+
+std::shared_ptr<AxmolRiveLoadRequest> AxmolRiveCache::loadFileAsync(std::string_view path,
+                                                                    AxmolRiveLoadCallback onLoaded,
+                                                                    AxmolRiveProgressCallback onProgress) {
+    auto request = std::make_shared<AxmolRiveLoadRequest>();
+    request->_path = path;
+    request->_onLoaded = std::move(onLoaded);
+    request->_onProgress = std::move(onProgress);
+
+    auto cached = _files.find(request->_path);
+    if (cached != _files.end()) {
+        // Still through the loader so the artboard is instanced off this thread, skipping the import
+        request->_file = cached->second;
+    } else {
+        // FileUtils' search paths are resolved here, the loader only reads
+        request->_fullPath = ax::FileUtils::getInstance()->fullPathForFilename(request->_path);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_loaderMutex);
+        if (!_loader.joinable()) {
+            _loader = std::thread(&AxmolRiveCache::loaderLoop, this);
+        }
+        _loads.push_back(request);
+    }
+    _loaderWake.notify_one();
+    return request;
+}
+
+void AxmolRiveCache::loaderLoop() {
+    std::unique_lock<std::mutex> lock(_loaderMutex);
+    while (true) {
+        _loaderWake.wait(lock, [this] { return _loaderQuit || !_loads.empty(); });
+        if (_loaderQuit) return;
+        auto request = std::move(_loads.front());
+        _loads.pop_front();
+        lock.unlock();
+
+        if (!request->isCancelled()) {
+            load(request);
+        }
+
+        lock.lock();
+    }
+}
+
+// Posts to the main thread, dropped when the request was cancelled by then
+static void postProgress(const std::shared_ptr<AxmolRiveLoadRequest>& request,
+                         const AxmolRiveProgressCallback& onProgress, float progress) {
+    if (!onProgress) return;
+    ax::Director::getInstance()->getScheduler()->runOnAxmolThread([request, onProgress, progress] {
+        if (!request->isCancelled()) onProgress(progress);
+    });
+}
+
+void AxmolRiveCache::load(const std::shared_ptr<AxmolRiveLoadRequest>& request) {
+    // Mapped when the file is on disk, else read in chunks for progress and cancellation
+    // (FileUtils streams work inside packages too)
+    static constexpr size_t ChunkSize = 256 * 1024;
+    static constexpr float ReadShare = 0.9f; // Of the progress, the import is the rest
+
+    auto file = std::move(request->_file);
+    AxmolFileMapping mapping;
+    if (!file && !request->_fullPath.empty() && mapping.map(request->_fullPath)) {
+        // Nothing to read ahead, pages come in as the import reaches them
+        request->_progress = ReadShare;
+        postProgress(request, request->_onProgress, ReadShare);
+
+        rive::ImportResult result;
+        file = _factory.importFile(rive::Span<const uint8_t>(mapping.data(), mapping.size()), &result);
+        mapping.unmap();
+        if (!file) {
+            AXLOGD("AxmolRiveCache: failed to import %s", request->_fullPath.c_str());
+        }
+    } else if (!file && !request->_fullPath.empty()) {
+        std::vector<uint8_t> bytes;
+        auto stream = ax::FileUtils::getInstance()->openFileStream(request->_fullPath, ax::IFileStream::Mode::READ);
+        int64_t size = stream ? stream->size() : -1;
+        if (size > 0) {
+            bytes.resize(static_cast<size_t>(size));
+            size_t offset = 0;
+            float reported = 0.0f;
+            while (offset < bytes.size()) {
+                if (request->isCancelled()) return;
+                size_t chunk = std::min(ChunkSize, bytes.size() - offset);
+                int read = stream->read(bytes.data() + offset, static_cast<unsigned int>(chunk));
+                if (read <= 0) break;
+                offset += static_cast<size_t>(read);
+
+                float progress = ReadShare * offset / bytes.size();
+                request->_progress = progress;
+                if (progress - reported >= 0.1f) {
+                    reported = progress;
+                    postProgress(request, request->_onProgress, progress);
+                }
+            }
+            bytes.resize(offset);
+        }
+        stream.reset();
+        if (request->isCancelled()) return;
+
+        if (!bytes.empty()) {
+            rive::ImportResult result;
+            file = _factory.importFile(rive::Span<const uint8_t>(bytes.data(), bytes.size()), &result);
+        }
+        if (!file) {
+            AXLOGD("AxmolRiveCache: failed to load %s", request->_fullPath.c_str());
+        }
+    }
+    if (request->isCancelled()) return;
+
+    // Instanced here too, cloning a large artboard is part of what shouldn't hitch the main thread
+    std::unique_ptr<AxmolRiveInstance> artboard;
+    if (file && file->artboardCount() > 0) {
+        artboard = std::make_unique<AxmolRiveInstance>();
+        artboard->file = file;
+        artboard->artboardIndex = 0;
+        artboard->artboard = file->artboardAt(0);
+        startScene(*artboard, {});
+        artboard->artboard->advance(0.0f);
+    }
+
+    request->_progress = 1.0f;
+    postProgress(request, request->_onProgress, 1.0f);
+    finish(request, std::move(file), std::move(artboard));
+}
+
+void AxmolRiveCache::finish(const std::shared_ptr<AxmolRiveLoadRequest>& request, rive::rcp<rive::File> file,
+                            std::unique_ptr<AxmolRiveInstance> artboard) {
+    // std::function needs a copyable capture
+    auto result = std::make_shared<std::pair<rive::rcp<rive::File>, std::unique_ptr<AxmolRiveInstance>>>(
+        std::move(file), std::move(artboard));
+    AxmolRiveCache* cache = this;
+    ax::Director::getInstance()->getScheduler()->runOnAxmolThread([cache, request, result] {
+        request->_done = true;
+        if (request->isCancelled() || s_sharedRiveCache != cache) return;
+
+        auto& file = result->first;
+        if (file) {
+            // When two loads of one path overlap, the first to finish is the one shared
+            cache->_files.emplace(request->_path, file);
+        }
+        if (request->_onLoaded) {
+            request->_onLoaded(file, std::move(result->second));
+        }
+    });
+}
+
+void AxmolRiveCache::addFile(std::string_view path, rive::rcp<rive::File> file) {
+    if (file) _files[std::string(path)] = std::move(file);
+}
+
+std::unique_ptr<AxmolRiveInstance> AxmolRiveCache::acquireInstance(const rive::rcp<rive::File>& file,
+                                                                   size_t artboardIndex,
+                                                                   std::string_view stateMachine) {
+    if (!file) return nullptr;
+
+    std::unique_ptr<AxmolRiveInstance> instance;
+    auto pool = _pools.find(PoolKey(file.get(), artboardIndex));
+    if (pool != _pools.end() && !pool->second.empty()) {
+        instance = std::move(pool->second.back());
+        pool->second.pop_back();
+    } else {
+        auto artboard = file->artboardAt(artboardIndex);
+        if (!artboard) return nullptr;
+        instance = std::make_unique<AxmolRiveInstance>();
+        instance->file = file;
+        instance->artboardIndex = artboardIndex;
+        instance->artboard = std::move(artboard);
+    }
+
+    // The scene is always new, so it starts from its entry state without stale pointer or input state
+    startScene(*instance, stateMachine);
+    instance->artboard->advance(0.0f);
+    return instance;
+}
+
+void AxmolRiveCache::startScene(AxmolRiveInstance& instance, std::string_view stateMachine) {
+    auto artboard = instance.artboard.get();
+    if (!stateMachine.empty()) {
+        instance.stateMachine = artboard->stateMachineNamed(std::string(stateMachine));
+    }
+    if (!instance.stateMachine) {
+        instance.stateMachine = artboard->stateMachineAt(0);
+    }
+    if (!instance.stateMachine) {
+        instance.stateMachine = artboard->defaultStateMachine();
+    }
+    if (!instance.stateMachine) {
+        instance.animation = artboard->animationAt(0);
+    }
+}
+
+void AxmolRiveCache::recycleInstance(std::unique_ptr<AxmolRiveInstance> instance) {
+    if (!instance || !instance->file || !instance->artboard) return;
+
+    auto& pool = _pools[PoolKey(instance->file.get(), instance->artboardIndex)];
+    if (pool.size() >= _maxPooledInstances) return;
+
+    instance->stateMachine.reset();
+    instance->animation.reset();
+    instance->frame = rive::AABB();
+    instance->fit = rive::Fit::contain;
+    instance->alignment = rive::Alignment::center;
+    instance->paused = false;
+    instance->changed = true;
+    instance->advanceSeconds = 0.0;
+    instance->drawSeconds = 0.0;
+    pool.push_back(std::move(instance));
+}
+
+void AxmolRiveCache::setMaxPooledInstances(size_t count) {
+    _maxPooledInstances = count;
+    for (auto& pool : _pools) {
+        if (pool.second.size() > count) pool.second.resize(count);
+    }
+}
+
+void AxmolRiveCache::purge() {
+    _pools.clear();
+    _files.clear();
+}
+
+int AxmolRiveCache::findArtboard(const rive::File& file, std::string_view name) {
+    if (file.artboardCount() == 0) return -1;
+    if (name.empty()) return 0;
+    for (size_t i = 0; i < file.artboardCount(); ++i) {
+        // The file's own artboard, no instance needed to read its name
+        auto artboard = file.artboard(i);
+        if (artboard && artboard->name() == name) return static_cast<int>(i);
+    }
+    return -1;
+}
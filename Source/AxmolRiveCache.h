@@ -0,0 +1,122 @@
+#ifndef _AXMOL_RIVE_CACHE_H_
+#define _AXMOL_RIVE_CACHE_H_
+
+#include "AxmolRive.h"
+#include "AxmolRiveScheduler.h"
+
+#include "rive/file.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Called on the main thread with the imported file and its first artboard, ready to play
+using AxmolRiveLoadCallback =
+    std::function<void(rive::rcp<rive::File> file, std::unique_ptr<AxmolRiveInstance> artboard)>;
+// Called on the main thread as a load advances, from 0 to 1
+using AxmolRiveProgressCallback = std::function<void(float progress)>;
+
+// Handle of an AxmolRiveCache::loadFileAsync call
+class AxmolRiveLoadRequest {
+public:
+    // No callback runs after this returns (when called on the main thread). The load itself
+    // stops at its next step.
+    void cancel() { _cancelled = true; }
+    bool isCancelled() const { return _cancelled; }
+    // Bytes read so far, then 1 once imported
+    float getProgress() const { return _progress; }
+    bool isDone() const { return _done; }
+
+private:
+    friend class AxmolRiveCache;
+
+    std::string _path;
+    std::string _fullPath;
+    rive::rcp<rive::File> _file; // Already cached, only the artboard is left to instance
+    AxmolRiveLoadCallback _onLoaded;
+    AxmolRiveProgressCallback _onProgress;
+    std::atomic<bool> _cancelled{false};
+    std::atomic<float> _progress{0.0f};
+    std::atomic<bool> _done{false};
+};
+
+// Shared loading state for Rive content, main thread only (loadFileAsync does its work on a
+// loader thread but calls back on the main thread). Each .riv is imported once per path
+// and shared by everything playing it. Artboard instances are recycled per (file, artboard)
+// instead of being cloned from the file again, so spawning and dropping many short-lived
+// players of the same artboard doesn't churn the heap.
+//
+// Files keep using the cache's factory for the render objects of new instances, destroy the
+// cache only once nothing uses its files anymore.
+class AxmolRiveCache {
+public:
+    static AxmolRiveCache* getInstance();
+    static void destroyInstance();
+
+    // File at 'path' (resolved through FileUtils), imported on first use. Null when it can't be loaded.
+    rive::rcp<rive::File> getFile(std::string_view path);
+    // Reads and imports 'path' on the loader thread, and instances its first artboard there too.
+    // onLoaded gets a null file when loading failed. Files already cached are handed back on
+    // the next frame. Requests run one at a time in the order made.
+    std::shared_ptr<AxmolRiveLoadRequest> loadFileAsync(std::string_view path, AxmolRiveLoadCallback onLoaded,
+                                                        AxmolRiveProgressCallback onProgress = nullptr);
+    // Registers a file imported elsewhere (with getFactory()) under 'path'
+    void addFile(std::string_view path, rive::rcp<rive::File> file);
+    AxmolFactory* getFactory() { return &_factory; }
+
+    // Artboard 'artboardIndex' of 'file', recycled when possible, with a new scene: the state
+    // machine named 'stateMachine', else the first (or default) one, else the first animation.
+    // Recycled artboards keep the pose they were left in until the new scene applies.
+    std::unique_ptr<AxmolRiveInstance> acquireInstance(const rive::rcp<rive::File>& file, size_t artboardIndex,
+                                                       std::string_view stateMachine = {});
+    // Returns an instance from acquireInstance for reuse, destroyed when its pool is full
+    void recycleInstance(std::unique_ptr<AxmolRiveInstance> instance);
+    // Instances kept per artboard, 32 by default
+    void setMaxPooledInstances(size_t count);
+
+    // Drops every pooled instance and forgets every file. Files still played stay alive
+    // through their players, a later getFile imports them again.
+    void purge();
+
+    // Index of the artboard named 'name', the first one when 'name' is empty, -1 when not found
+    static int findArtboard(const rive::File& file, std::string_view name);
+
+    // Gives a fresh instance its scene: the state machine named 'stateMachine', else the first
+    // (or default) one, else the first animation
+    static void startScene(AxmolRiveInstance& instance, std::string_view stateMachine);
+
+private:
+    using PoolKey = std::pair<const rive::File*, size_t>;
+
+    AxmolRiveCache() = default;
+    ~AxmolRiveCache();
+
+    void loaderLoop();
+    void load(const std::shared_ptr<AxmolRiveLoadRequest>& request);
+    void finish(const std::shared_ptr<AxmolRiveLoadRequest>& request, rive::rcp<rive::File> file,
+                std::unique_ptr<AxmolRiveInstance> artboard);
+
+    AxmolFactory _factory;
+    std::unordered_map<std::string, rive::rcp<rive::File>> _files;
+    std::map<PoolKey, std::vector<std::unique_ptr<AxmolRiveInstance>>> _pools;
+    size_t _maxPooledInstances = 32;
+
+    // Loader thread, started by the first loadFileAsync
+    std::thread _loader;
+    std::mutex _loaderMutex;
+    std::condition_variable _loaderWake;
+    std::deque<std::shared_ptr<AxmolRiveLoadRequest>> _loads;
+    bool _loaderQuit = false;
+};
+
+#endif // _AXMOL_RIVE_CACHE_H_
@@ -0,0 +1,151 @@
+#include "AxmolRiveScheduler.h"
+#include "AxmolRive.h"
+#include "AxmolJobs.h"
+
+#include <algorithm> // For std::find_if
+#include <chrono>
+
+using Clock = std::chrono::steady_clock;
+
+static double secondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// AxmolRiveInstance Implementation
+bool AxmolRiveInstance::advance(float dt) {
+    // The scene first, then the artboard for animations
+    if (stateMachine) {
+        return stateMachine->advance(dt);
+    }
+    if (animation) {
+        bool animationChanged = animation->advance(dt);
+        animation->apply();
+        return artboard->advance(dt) || animationChanged; // Still needed to update components
+    }
+    return artboard->advance(dt);
+}
+
+void AxmolRiveInstance::draw(AxmolRenderer* renderer) const {
+    renderer->save();
+    renderer->align(fit, alignment, frame, artboard->bounds());
+    artboard->draw(renderer);
+    renderer->restore();
+}
+
+rive::Mat2D AxmolRiveInstance::transform() const {
+    return rive::computeAlignment(fit, alignment, frame, artboard->bounds());
+}
+
+bool AxmolRiveInstance::toArtboard(rive::Vec2D point, rive::Vec2D& out) const {
+    rive::Mat2D inverse;
+    if (!transform().invert(&inverse)) return false;
+    out = inverse * point;
+    return true;
+}
+
+// AxmolRiveScheduler Implementation
+AxmolRiveInstance* AxmolRiveScheduler::add(std::unique_ptr<rive::ArtboardInstance> artboard,
+                                           std::unique_ptr<rive::StateMachineInstance> stateMachine,
+                                           std::unique_ptr<rive::LinearAnimationInstance> animation) {
+    if (!artboard) return nullptr;
+
+    auto instance = std::make_unique<AxmolRiveInstance>();
+    instance->artboard = std::move(artboard);
+    instance->stateMachine = std::move(stateMachine);
+    instance->animation = std::move(animation);
+    instance->artboard->advance(0.0f);
+    return add(std::move(instance));
+}
+
+AxmolRiveInstance* AxmolRiveScheduler::add(std::unique_ptr<AxmolRiveInstance> instance) {
+    if (!instance || !instance->artboard) return nullptr;
+    _instances.push_back(std::move(instance));
+    return _instances.back().get();
+}
+
+AxmolRiveInstance* AxmolRiveScheduler::add(rive::File& file, size_t artboardIndex) {
+    auto artboard = file.artboardAt(artboardIndex);
+    if (!artboard) return nullptr;
+
+    auto stateMachine = artboard->stateMachineAt(0);
+    if (!stateMachine) {
+        stateMachine = artboard->defaultStateMachine();
+    }
+    std::unique_ptr<rive::LinearAnimationInstance> animation;
+    if (!stateMachine) {
+        animation = artboard->animationAt(0);
+    }
+    return add(std::move(artboard), std::move(stateMachine), std::move(animation));
+}
+
+void AxmolRiveScheduler::remove(AxmolRiveInstance* instance) {
+    release(instance);
+}
+
+std::unique_ptr<AxmolRiveInstance> AxmolRiveScheduler::release(AxmolRiveInstance* instance) {
+    auto it = std::find_if(_instances.begin(), _instances.end(),
+                           [instance](const std::unique_ptr<AxmolRiveInstance>& i) { return i.get() == instance; });
+    if (it == _instances.end()) return nullptr;
+    auto owned = std::move(*it);
+    _instances.erase(it);
+    return owned;
+}
+
+void AxmolRiveScheduler::clear() {
+    _instances.clear();
+}
+
+bool AxmolRiveScheduler::advance(float dt) {
+    auto run = [this, dt](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            auto& instance = *_instances[i];
+            if (instance.paused) {
+                instance.changed = false;
+                instance.advanceSeconds = 0.0;
+                continue;
+            }
+            auto start = Clock::now();
+            instance.changed = instance.advance(dt);
+            instance.advanceSeconds = secondsSince(start);
+        }
+    };
+    if (_parallel) {
+        AxmolJobs::shared().parallelFor(_instances.size(), 1, run);
+    } else {
+        run(0, _instances.size());
+    }
+
+    // Collected after the join, each job only wrote its own instance
+    bool changed = false;
+    for (const auto& instance : _instances) {
+        changed = changed || instance->changed;
+    }
+    return changed;
+}
+
+void AxmolRiveScheduler::draw(AxmolRenderer* renderer) {
+    for (const auto& instance : _instances) {
+        instance->drawSeconds = 0.0;
+        if (instance->frame.width() <= 0.0f || instance->frame.height() <= 0.0f) continue;
+
+        auto start = Clock::now();
+        instance->draw(renderer);
+        instance->drawSeconds = secondsSince(start);
+    }
+}
+
+double AxmolRiveScheduler::getAdvanceSeconds() const {
+    double seconds = 0.0;
+    for (const auto& instance : _instances) {
+        seconds += instance->advanceSeconds;
+    }
+    return seconds;
+}
+
+double AxmolRiveScheduler::getDrawSeconds() const {
+    double seconds = 0.0;
+    for (const auto& instance : _instances) {
+        seconds += instance->drawSeconds;
+    }
+    return seconds;
+}
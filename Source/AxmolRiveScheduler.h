@@ -0,0 +1,90 @@
+#ifndef _AXMOL_RIVE_SCHEDULER_H_
+#define _AXMOL_RIVE_SCHEDULER_H_
+
+#include "rive/file.hpp"
+#include "rive/artboard.hpp"
+#include "rive/animation/state_machine_instance.hpp"
+#include "rive/animation/linear_animation_instance.hpp"
+#include "rive/layout.hpp"
+#include "rive/math/aabb.hpp"
+#include "rive/math/mat2d.hpp"
+
+#include <memory>
+#include <vector>
+
+class AxmolRenderer;
+
+// One artboard instance played by AxmolRiveScheduler, with the scene driving it: its state
+// machine, else a linear animation, else nothing (static artboard).
+struct AxmolRiveInstance {
+    // Source of the artboard when created through AxmolRiveCache, declared first so it outlives it
+    rive::rcp<rive::File> file;
+    size_t artboardIndex = 0;
+
+    std::unique_ptr<rive::ArtboardInstance> artboard;
+    std::unique_ptr<rive::StateMachineInstance> stateMachine;
+    std::unique_ptr<rive::LinearAnimationInstance> animation;
+
+    // Where the artboard is drawn, in renderer output space. Empty frames aren't drawn.
+    rive::AABB frame;
+    rive::Fit fit = rive::Fit::contain;
+    rive::Alignment alignment = rive::Alignment::center;
+    bool paused = false;
+
+    // Written by the scheduler each frame
+    bool changed = true;          // Last advance changed something or is still moving
+    double advanceSeconds = 0.0;  // Last advance, on whichever thread ran it
+    double drawSeconds = 0.0;     // Last draw (recording into the renderer)
+
+    // Advances the scene (or the artboard alone), returns true when anything changed or is still moving
+    bool advance(float dt);
+    // Draws the artboard aligned into 'frame'
+    void draw(AxmolRenderer* renderer) const;
+
+    // Artboard to output space, as drawn
+    rive::Mat2D transform() const;
+    // Output space point to artboard space, false when the transform can't be inverted
+    bool toArtboard(rive::Vec2D point, rive::Vec2D& out) const;
+};
+
+// Plays many artboard instances. advance() runs them in parallel on the AxmolJobs pool, one
+// instance per job taken from a shared counter, so a few expensive instances don't hold up the
+// rest. draw() then records them on the calling thread in the order they were added.
+//
+// Instances only touch their own objects while advancing. Several may come from the same
+// rive::File, which is only read.
+class AxmolRiveScheduler {
+public:
+    // Takes ownership, returns the instance (stable until removed)
+    AxmolRiveInstance* add(std::unique_ptr<rive::ArtboardInstance> artboard,
+                           std::unique_ptr<rive::StateMachineInstance> stateMachine = nullptr,
+                           std::unique_ptr<rive::LinearAnimationInstance> animation = nullptr);
+    // Instances artboard 'index' of 'file' with its first (or default) state machine, else its first animation
+    AxmolRiveInstance* add(rive::File& file, size_t artboardIndex);
+    AxmolRiveInstance* add(std::unique_ptr<AxmolRiveInstance> instance);
+    void remove(AxmolRiveInstance* instance);
+    // Removes without destroying, e.g. to recycle it through AxmolRiveCache
+    std::unique_ptr<AxmolRiveInstance> release(AxmolRiveInstance* instance);
+    void clear();
+
+    size_t size() const { return _instances.size(); }
+    AxmolRiveInstance* at(size_t index) const { return _instances[index].get(); }
+
+    // Advance on the calling thread only, for profiling or platforms without spare cores
+    void setParallel(bool enabled) { _parallel = enabled; }
+
+    // Advances every unpaused instance by dt, returns true when any of them changed
+    bool advance(float dt);
+    // Records every instance with a frame into the renderer, in insertion order
+    void draw(AxmolRenderer* renderer);
+
+    // Sums over all instances of the last advance/draw
+    double getAdvanceSeconds() const;
+    double getDrawSeconds() const;
+
+private:
+    std::vector<std::unique_ptr<AxmolRiveInstance>> _instances;
+    bool _parallel = true;
+};
+
+#endif // _AXMOL_RIVE_SCHEDULER_H_
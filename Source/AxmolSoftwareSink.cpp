@@ -0,0 +1,455 @@
+#include "AxmolSoftwareSink.h"
+#include "AxmolRive.h"
+#include "AxmolKernels.h"
+#include "AxmolImageAtlas.h"
+
+#include <algorithm> // For std::min, std::max, std::fill, std::copy, std::swap
+#include <cmath>
+
+struct ColorF {
+    float r, g, b, a;
+};
+
+static ColorF toColorF(ax::Color32 c) {
+    return {c.r / 255.0f, c.g / 255.0f, c.b / 255.0f, c.a / 255.0f};
+}
+
+static ColorF multiply(ColorF a, ColorF b) {
+    return {a.r * b.r, a.g * b.g, a.b * b.b, a.a * b.a};
+}
+
+static uint8_t toByte(float v) {
+    return static_cast<uint8_t>(std::min(1.0f, std::max(0.0f, v)) * 255.0f + 0.5f);
+}
+
+// Same as gradientColor() in rive_path.frag
+static ColorF gradientColor(const AxmolGradientUniforms& g, rive::Vec2D p) {
+    float t = 0.0f;
+    if (g.type[0] < 1.5f) {
+        float dx = g.points[2] - g.points[0];
+        float dy = g.points[3] - g.points[1];
+        float lenSq = dx * dx + dy * dy;
+        if (lenSq > 0.0001f) t = ((p.x - g.points[0]) * dx + (p.y - g.points[1]) * dy) / lenSq;
+    } else {
+        float radius = g.points[2];
+        if (radius > 0.0001f) t = std::hypot(p.x - g.points[0], p.y - g.points[1]) / radius;
+    }
+    t = std::min(1.0f, std::max(0.0f, t));
+
+    auto stop = [&g](int i) {
+        const float* c = g.stopColors + i * 4;
+        return ColorF{c[0], c[1], c[2], c[3]};
+    };
+
+    int count = static_cast<int>(g.type[1]);
+    if (count <= 0) return {1.0f, 1.0f, 1.0f, 1.0f};
+    if (t <= g.stopOffsets[0]) return stop(0);
+
+    for (int i = 1; i < count; ++i) {
+        float prev = g.stopOffsets[i - 1];
+        float next = g.stopOffsets[i];
+        if (t <= next) {
+            float range = next - prev;
+            float f = range > 0.0f ? (t - prev) / range : 1.0f;
+            ColorF a = stop(i - 1);
+            ColorF b = stop(i);
+            return {a.r + (b.r - a.r) * f, a.g + (b.g - a.g) * f, a.b + (b.b - a.b) * f, a.a + (b.a - a.a) * f};
+        }
+    }
+    return stop(count - 1);
+}
+
+// GL_LINEAR with clamp to edge, texel centers at half pixels. Pages are premultiplied, the
+// result is straight alpha like every other source shadePixel composites.
+static ColorF sampleImage(const AxmolImagePage& page, rive::Vec2D uv) {
+    const int w = page.width();
+    const int h = page.height();
+    float x = std::min(static_cast<float>(w - 1), std::max(0.0f, uv.x * w - 0.5f));
+    float y = std::min(static_cast<float>(h - 1), std::max(0.0f, uv.y * h - 0.5f));
+    int x0 = static_cast<int>(x);
+    int y0 = static_cast<int>(y);
+    int x1 = std::min(w - 1, x0 + 1);
+    int y1 = std::min(h - 1, y0 + 1);
+    float fx = x - x0;
+    float fy = y - y0;
+
+    const uint8_t* pixels = page.pixels();
+    auto texel = [pixels, w](int tx, int ty, int c) { return pixels[(static_cast<size_t>(ty) * w + tx) * 4 + c]; };
+    float out[4];
+    for (int c = 0; c < 4; ++c) {
+        float top = texel(x0, y0, c) + (texel(x1, y0, c) - texel(x0, y0, c)) * fx;
+        float bottom = texel(x0, y1, c) + (texel(x1, y1, c) - texel(x0, y1, c)) * fx;
+        out[c] = (top + (bottom - top) * fy) / 255.0f;
+    }
+    if (out[3] <= 0.0f) return {0.0f, 0.0f, 0.0f, 0.0f};
+    return {out[0] / out[3], out[1] / out[3], out[2] / out[3], out[3]};
+}
+
+// Separable blend functions of the W3C compositing spec, 'b' the backdrop and 's' the source
+static float blendChannel(rive::BlendMode mode, float b, float s) {
+    switch (mode) {
+        case rive::BlendMode::multiply:
+            return b * s;
+        case rive::BlendMode::screen:
+            return b + s - b * s;
+        case rive::BlendMode::overlay:
+            return blendChannel(rive::BlendMode::hardLight, s, b);
+        case rive::BlendMode::darken:
+            return std::min(b, s);
+        case rive::BlendMode::lighten:
+            return std::max(b, s);
+        case rive::BlendMode::colorDodge:
+            if (b <= 0.0f) return 0.0f;
+            return s >= 1.0f ? 1.0f : std::min(1.0f, b / (1.0f - s));
+        case rive::BlendMode::colorBurn:
+            if (b >= 1.0f) return 1.0f;
+            return s <= 0.0f ? 0.0f : 1.0f - std::min(1.0f, (1.0f - b) / s);
+        case rive::BlendMode::hardLight:
+            return s <= 0.5f ? b * 2.0f * s : blendChannel(rive::BlendMode::screen, b, 2.0f * s - 1.0f);
+        case rive::BlendMode::softLight: {
+            if (s <= 0.5f) return b - (1.0f - 2.0f * s) * b * (1.0f - b);
+            float d = b <= 0.25f ? ((16.0f * b - 12.0f) * b + 4.0f) * b : std::sqrt(b);
+            return b + (2.0f * s - 1.0f) * (d - b);
+        }
+        case rive::BlendMode::difference:
+            return std::abs(b - s);
+        case rive::BlendMode::exclusion:
+            return b + s - 2.0f * b * s;
+        default:
+            return s;
+    }
+}
+
+static float luminosity(const float c[3]) {
+    return 0.3f * c[0] + 0.59f * c[1] + 0.11f * c[2];
+}
+
+static void setLuminosity(float c[3], float l) {
+    float d = l - luminosity(c);
+    for (int i = 0; i < 3; ++i) c[i] += d;
+    // ClipColor
+    l = luminosity(c);
+    float lo = std::min(c[0], std::min(c[1], c[2]));
+    float hi = std::max(c[0], std::max(c[1], c[2]));
+    for (int i = 0; i < 3; ++i) {
+        if (lo < 0.0f) c[i] = l + (c[i] - l) * l / (l - lo);
+        if (hi > 1.0f) c[i] = l + (c[i] - l) * (1.0f - l) / (hi - l);
+    }
+}
+
+static float saturation(const float c[3]) {
+    return std::max(c[0], std::max(c[1], c[2])) - std::min(c[0], std::min(c[1], c[2]));
+}
+
+static void setSaturation(float c[3], float s) {
+    int hi = 0, mid = 1, lo = 2;
+    if (c[hi] < c[mid]) std::swap(hi, mid);
+    if (c[mid] < c[lo]) std::swap(mid, lo);
+    if (c[hi] < c[mid]) std::swap(hi, mid);
+    if (c[hi] > c[lo]) {
+        c[mid] = (c[mid] - c[lo]) * s / (c[hi] - c[lo]);
+        c[hi] = s;
+    } else {
+        c[mid] = c[hi] = 0.0f;
+    }
+    c[lo] = 0.0f;
+}
+
+// B(backdrop, source) of any Rive blend mode, on straight colors
+static void blendColor(rive::BlendMode mode, const float b[3], const float s[3], float out[3]) {
+    switch (mode) {
+        case rive::BlendMode::hue:
+            std::copy(s, s + 3, out);
+            setSaturation(out, saturation(b));
+            setLuminosity(out, luminosity(b));
+            return;
+        case rive::BlendMode::saturation:
+            std::copy(b, b + 3, out);
+            setSaturation(out, saturation(s));
+            setLuminosity(out, luminosity(b));
+            return;
+        case rive::BlendMode::color:
+            std::copy(s, s + 3, out);
+            setLuminosity(out, luminosity(b));
+            return;
+        case rive::BlendMode::luminosity:
+            std::copy(b, b + 3, out);
+            setLuminosity(out, luminosity(s));
+            return;
+        default:
+            for (int i = 0; i < 3; ++i) out[i] = blendChannel(mode, b[i], s[i]);
+            return;
+    }
+}
+
+static float edge(rive::Vec2D a, rive::Vec2D b, rive::Vec2D c) {
+    return (b.x - a.x) * (c.y - a.y) - (b.y - a.y) * (c.x - a.x);
+}
+
+// Of the two triangles sharing an edge, only one owns pixel centers exactly on it.
+// The edge runs in opposite directions in each of them, so any antisymmetric rule works.
+static bool ownsEdge(rive::Vec2D a, rive::Vec2D b) {
+    float dy = b.y - a.y;
+    return dy > 0.0f || (dy == 0.0f && b.x < a.x);
+}
+
+AxmolSoftwareSink::AxmolSoftwareSink(int width, int height)
+    : _width(std::max(1, width))
+    , _height(std::max(1, height)) {
+    _pixels.resize(static_cast<size_t>(_width) * _height * 4);
+    _stencil.resize(static_cast<size_t>(_width) * _height);
+    clear();
+}
+
+AxmolSoftwareSink::~AxmolSoftwareSink() {
+    for (auto& clip : _clips) {
+        AX_SAFE_RELEASE(clip.mesh);
+    }
+}
+
+bool AxmolSoftwareSink::saveToFile(std::string_view path) const {
+    // Image files are straight alpha, the buffer is premultiplied
+    std::vector<uint8_t> straight(_pixels.size());
+    for (size_t i = 0; i < _pixels.size(); i += 4) {
+        const int a = _pixels[i + 3];
+        for (size_t c = 0; c < 3; ++c) {
+            straight[i + c] = a == 0 ? 0 : static_cast<uint8_t>(std::min(255, (_pixels[i + c] * 255 + a / 2) / a));
+        }
+        straight[i + 3] = static_cast<uint8_t>(a);
+    }
+    auto image = new ax::Image();
+    bool ok = image->initWithRawData(straight.data(), static_cast<ssize_t>(straight.size()), _width, _height, 8, false) &&
+              image->saveToFile(path, false);
+    image->release();
+    return ok;
+}
+
+void AxmolSoftwareSink::clear() {
+    for (size_t i = 0; i < _pixels.size(); i += 4) {
+        _pixels[i] = _clearColor.r;
+        _pixels[i + 1] = _clearColor.g;
+        _pixels[i + 2] = _clearColor.b;
+        _pixels[i + 3] = _clearColor.a;
+    }
+    std::fill(_stencil.begin(), _stencil.end(), 0);
+    for (auto& clip : _clips) {
+        AX_SAFE_RELEASE(clip.mesh);
+    }
+    _clips.clear();
+    _triangleCount = 0;
+    _drawCallCount = 0;
+    _blendMode = rive::BlendMode::srcOver;
+}
+
+AxmolSoftwareSink::Fill AxmolSoftwareSink::contentFill() const {
+    Fill fill;
+    fill.stencilRef = static_cast<uint8_t>(_clips.size());
+    fill.blendMode = _blendMode;
+    return fill;
+}
+
+void AxmolSoftwareSink::drawMesh(AxmolGpuMesh* mesh, const rive::Mat2D& m, ax::Color32 color,
+                                 const AxmolGradientUniforms* gradient) {
+    if (!mesh || mesh->indexCount() == 0) return;
+
+    Fill fill = contentFill();
+    fill.color = color;
+    fill.gradient = gradient;
+    rasterize(mesh->vertices(), mesh->indices(), m, fill);
+}
+
+void AxmolSoftwareSink::drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                                      const rive::Mat2D& m, const AxmolRenderShader* shader) {
+    if (indices.size() < 3) return;
+
+    Fill fill = contentFill();
+    fill.shader = shader;
+    rasterize(vertices, indices, m, fill);
+}
+
+void AxmolSoftwareSink::drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m, ax::Color32 color,
+                                  const AxmolGradientUniforms* gradient) {
+    Fill fill = contentFill();
+    fill.color = color;
+    fill.gradient = gradient;
+    rasterize(strip, {}, m, fill);
+}
+
+void AxmolSoftwareSink::drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m,
+                                  const AxmolRenderShader* shader) {
+    Fill fill = contentFill();
+    fill.shader = shader;
+    rasterize(strip, {}, m, fill);
+}
+
+void AxmolSoftwareSink::drawImage(const AxmolRenderImage* image, rive::Span<const rive::Vec2D> vertices,
+                                  rive::Span<const rive::Vec2D> uvs, rive::Span<const uint16_t> indices,
+                                  const rive::Mat2D& m, float opacity) {
+    auto page = image ? image->page() : nullptr;
+    if (!page || page->width() == 0 || page->height() == 0 || indices.size() < 3 || uvs.size() < vertices.size()) {
+        return;
+    }
+    // Freed after a GPU upload, see AxmolImagePage::setKeepPixels
+    if (!page->hasPixels()) return;
+
+    Fill fill = contentFill();
+    fill.color = ax::Color32(255, 255, 255, toByte(opacity));
+    fill.image = image;
+    rasterize(vertices, indices, m, fill, uvs);
+}
+
+void AxmolSoftwareSink::drawClip(const AxmolClip& clip, Fill::Mode mode, uint8_t ref) {
+    if (!clip.mesh || clip.mesh->indexCount() == 0) return;
+
+    Fill fill;
+    fill.mode = mode;
+    fill.stencilRef = ref;
+    rasterize(clip.mesh->vertices(), clip.mesh->indices(), clip.matrix, fill);
+}
+
+void AxmolSoftwareSink::setClips(const std::vector<AxmolClip>& clips) {
+    // Same stencil scheme as AxmolMeshNode: a push increments where the stencil equals
+    // the current depth, a pop draws the clip again to decrement
+    size_t common = 0;
+    while (common < clips.size() && common < _clips.size() && clips[common] == _clips[common]) {
+        ++common;
+    }
+    while (_clips.size() > common) {
+        AxmolClip clip = _clips.back();
+        drawClip(clip, Fill::Mode::decrement, static_cast<uint8_t>(_clips.size()));
+        AX_SAFE_RELEASE(clip.mesh);
+        _clips.pop_back();
+    }
+    for (size_t i = common; i < clips.size(); ++i) {
+        AxmolClip clip = clips[i];
+        AX_SAFE_RETAIN(clip.mesh);
+        drawClip(clip, Fill::Mode::increment, static_cast<uint8_t>(_clips.size()));
+        _clips.push_back(clip);
+    }
+}
+
+void AxmolSoftwareSink::rasterize(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                                  const rive::Mat2D& m, const Fill& fill, rive::Span<const rive::Vec2D> attributes) {
+    if (vertices.size() < 3) return;
+    ++_drawCallCount;
+    if (attributes.empty()) attributes = vertices;
+
+    const float matrix[6] = {m[0], m[1], m[2], m[3], m[4], m[5]};
+    _screen.resize(vertices.size());
+    AxmolKernels::transformPoints(matrix, &vertices[0].x, vertices.size(), _screen.data(), sizeof(rive::Vec2D));
+
+    rive::Vec2D screen[3];
+    rive::Vec2D local[3];
+    if (indices.empty()) {
+        for (size_t i = 0; i + 2 < vertices.size(); ++i) {
+            for (int k = 0; k < 3; ++k) {
+                screen[k] = _screen[i + k];
+                local[k] = attributes[i + k];
+            }
+            rasterizeTriangle(screen, local, fill);
+        }
+        return;
+    }
+
+    for (size_t i = 0; i + 2 < indices.size(); i += 3) {
+        for (int k = 0; k < 3; ++k) {
+            uint16_t index = indices[i + k];
+            if (index >= vertices.size()) return;
+            screen[k] = _screen[index];
+            local[k] = attributes[index];
+        }
+        rasterizeTriangle(screen, local, fill);
+    }
+}
+
+void AxmolSoftwareSink::rasterizeTriangle(const rive::Vec2D screen[3], const rive::Vec2D local[3], const Fill& fill) {
+    rive::Vec2D p0 = screen[0], p1 = screen[1], p2 = screen[2];
+    rive::Vec2D l0 = local[0], l1 = local[1], l2 = local[2];
+
+    float area = edge(p0, p1, p2);
+    if (!(std::abs(area) > 1e-12f)) return; // Degenerate or NaN
+    if (area < 0.0f) {
+        std::swap(p1, p2);
+        std::swap(l1, l2);
+        area = -area;
+    }
+    ++_triangleCount;
+
+    // Pixel centers inside the bounds, clamped before converting so huge coordinates can't overflow
+    float minX = std::max(0.0f, std::floor(std::min({p0.x, p1.x, p2.x})));
+    float minY = std::max(0.0f, std::floor(std::min({p0.y, p1.y, p2.y})));
+    float maxX = std::min(static_cast<float>(_width - 1), std::ceil(std::max({p0.x, p1.x, p2.x})));
+    float maxY = std::min(static_cast<float>(_height - 1), std::ceil(std::max({p0.y, p1.y, p2.y})));
+    if (minX > maxX || minY > maxY) return;
+
+    const bool own0 = ownsEdge(p1, p2);
+    const bool own1 = ownsEdge(p2, p0);
+    const bool own2 = ownsEdge(p0, p1);
+    const float invArea = 1.0f / area;
+
+    for (int y = static_cast<int>(minY); y <= static_cast<int>(maxY); ++y) {
+        for (int x = static_cast<int>(minX); x <= static_cast<int>(maxX); ++x) {
+            rive::Vec2D c(x + 0.5f, y + 0.5f);
+            float w0 = edge(p1, p2, c);
+            float w1 = edge(p2, p0, c);
+            float w2 = edge(p0, p1, c);
+            if (w0 < 0.0f || w1 < 0.0f || w2 < 0.0f) continue;
+            if ((w0 == 0.0f && !own0) || (w1 == 0.0f && !own1) || (w2 == 0.0f && !own2)) continue;
+
+            // Affine, so the barycentric mix of the local positions is exact
+            float b0 = w0 * invArea;
+            float b1 = w1 * invArea;
+            float b2 = w2 * invArea;
+            rive::Vec2D p(l0.x * b0 + l1.x * b1 + l2.x * b2, l0.y * b0 + l1.y * b1 + l2.y * b2);
+            shadePixel(static_cast<size_t>(y) * _width + x, p, fill);
+        }
+    }
+}
+
+void AxmolSoftwareSink::shadePixel(size_t index, rive::Vec2D local, const Fill& fill) {
+    uint8_t& stencil = _stencil[index];
+    switch (fill.mode) {
+        case Fill::Mode::increment:
+            if (stencil == fill.stencilRef) ++stencil;
+            return;
+        case Fill::Mode::decrement:
+            if (stencil == fill.stencilRef) --stencil;
+            return;
+        case Fill::Mode::color:
+            if (fill.stencilRef != 0 && stencil != fill.stencilRef) return;
+            break;
+    }
+
+    ColorF src = toColorF(fill.color);
+    if (fill.shader) src = multiply(src, toColorF(fill.shader->getColor(local.x, local.y)));
+    if (fill.gradient && fill.gradient->type[0] > 0.5f) src = multiply(src, gradientColor(*fill.gradient, local));
+    if (fill.image) src = multiply(src, sampleImage(*fill.image->page(), fill.image->pageUV(local)));
+    if (src.a <= 0.0f) return;
+
+    // Premultiplied source over a premultiplied buffer, ONE, ONE_MINUS_SRC_ALPHA like the
+    // srcOver state of the rive_path pipeline
+    uint8_t* dst = &_pixels[index * 4];
+    float a = std::min(1.0f, src.a);
+    float inv = 1.0f - a;
+    float backdropAlpha = dst[3] / 255.0f;
+    if (fill.blendMode == rive::BlendMode::srcOver) {
+        dst[0] = toByte(src.r * a + dst[0] / 255.0f * inv);
+        dst[1] = toByte(src.g * a + dst[1] / 255.0f * inv);
+        dst[2] = toByte(src.b * a + dst[2] / 255.0f * inv);
+    } else {
+        // Separable and non-separable modes on the straight backdrop, composited as
+        // s * (1 - ab) + b * (1 - as) + as * ab * B(b, s)
+        float backdrop[3];
+        for (int i = 0; i < 3; ++i) {
+            backdrop[i] = backdropAlpha > 0.0f ? std::min(1.0f, dst[i] / 255.0f / backdropAlpha) : 0.0f;
+        }
+        const float source[3] = {src.r, src.g, src.b};
+        float mixed[3];
+        blendColor(fill.blendMode, backdrop, source, mixed);
+        for (int i = 0; i < 3; ++i) {
+            dst[i] = toByte(source[i] * a * (1.0f - backdropAlpha) + dst[i] / 255.0f * inv +
+                            a * backdropAlpha * mixed[i]);
+        }
+    }
+    dst[3] = toByte(a + backdropAlpha * inv);
+}
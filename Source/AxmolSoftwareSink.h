@@ -0,0 +1,89 @@
+#ifndef _AXMOL_SOFTWARE_SINK_H_
+#define _AXMOL_SOFTWARE_SINK_H_
+
+#include "AxmolRenderSink.h"
+
+#include <string_view>
+#include <vector>
+
+// Rasterizes AxmolRenderer output on the CPU into an RGBA8 buffer, for rendering frames
+// without a display or GPU (validation, thumbnails, CI). Follows the rive_path program:
+// one sample at each pixel center, gradients per pixel, premultiplied blending and
+// clips through an 8-bit stencil, so its output matches AxmolMeshNode without MSAA.
+// Blend modes are computed exactly from the destination pixel, including the ones
+// AxmolMeshNode can't draw (it falls back to srcOver for those).
+class AxmolSoftwareSink : public AxmolRenderSink {
+public:
+    AxmolSoftwareSink(int width, int height);
+    ~AxmolSoftwareSink() override;
+
+    // Color the buffer is cleared to at the start of each frame, premultiplied
+    void setClearColor(ax::Color32 color) { _clearColor = color; }
+
+    int getWidth() const { return _width; }
+    int getHeight() const { return _height; }
+    // Rows from top to bottom (Rive's y down), 4 bytes per pixel, premultiplied
+    const uint8_t* getPixels() const { return _pixels.data(); }
+    // Triangles rasterized since the last clear, clip triangles included
+    size_t getTriangleCount() const { return _triangleCount; }
+    // One per draw and clip mesh, nothing is batched
+    size_t getDrawCallCount() const override { return _drawCallCount; }
+
+    // Writes the current frame as PNG (or any format ax::Image saves by extension), with
+    // straight alpha like any image file
+    bool saveToFile(std::string_view path) const;
+
+    void clear() override;
+    void drawMesh(AxmolGpuMesh* mesh, const rive::Mat2D& m, ax::Color32 color,
+                  const AxmolGradientUniforms* gradient = nullptr) override;
+    void drawTriangles(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                       const rive::Mat2D& m, const AxmolRenderShader* shader) override;
+    void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m, ax::Color32 color,
+                   const AxmolGradientUniforms* gradient = nullptr) override;
+    void drawStrip(rive::Span<const rive::Vec2D> strip, const rive::Mat2D& m,
+                   const AxmolRenderShader* shader) override;
+    void drawImage(const AxmolRenderImage* image, rive::Span<const rive::Vec2D> vertices, rive::Span<const rive::Vec2D> uvs,
+                   rive::Span<const uint16_t> indices, const rive::Mat2D& m, float opacity) override;
+    void setClips(const std::vector<AxmolClip>& clips) override;
+    void setBlendMode(rive::BlendMode mode) override { _blendMode = mode; }
+
+private:
+    // What a triangle does to the pixels it covers
+    struct Fill {
+        enum class Mode : uint8_t {
+            color,     // Blend the shaded color where the stencil matches the clip depth
+            increment, // Clip push, no color
+            decrement, // Clip pop, no color
+        };
+
+        Mode mode = Mode::color;
+        uint8_t stencilRef = 0;
+        rive::BlendMode blendMode = rive::BlendMode::srcOver;
+        ax::Color32 color = ax::Color32::WHITE;
+        const AxmolGradientUniforms* gradient = nullptr;
+        const AxmolRenderShader* shader = nullptr; // Evaluated per pixel at the local position
+        const AxmolRenderImage* image = nullptr;   // Sampled bilinearly at the interpolated uv
+    };
+
+    // Triangles given as indices (or as a strip when 'indices' is empty) into local vertices.
+    // 'attributes' (one per vertex) are interpolated instead of the local positions when given.
+    void rasterize(rive::Span<const rive::Vec2D> vertices, rive::Span<const uint16_t> indices,
+                   const rive::Mat2D& m, const Fill& fill, rive::Span<const rive::Vec2D> attributes = {});
+    void rasterizeTriangle(const rive::Vec2D screen[3], const rive::Vec2D local[3], const Fill& fill);
+    void shadePixel(size_t index, rive::Vec2D local, const Fill& fill);
+    void drawClip(const AxmolClip& clip, Fill::Mode mode, uint8_t ref);
+    Fill contentFill() const;
+
+    int _width = 0;
+    int _height = 0;
+    ax::Color32 _clearColor = ax::Color32(0, 0, 0, 0);
+    std::vector<uint8_t> _pixels;
+    std::vector<uint8_t> _stencil;
+    std::vector<AxmolClip> _clips; // Meshes retained
+    rive::BlendMode _blendMode = rive::BlendMode::srcOver;
+    std::vector<rive::Vec2D> _screen; // Scratch for transformed vertices
+    size_t _triangleCount = 0;
+    size_t _drawCallCount = 0;
+};
+
+#endif // _AXMOL_SOFTWARE_SINK_H_
@@ -1,5 +1,7 @@
 #include "MainScene.h"
 #include "AxmolRive.h"
+#include "AxmolFramePipeline.h"
+#include "AxmolRiveCache.h"
 #include "rive/file.hpp"
 #include "rive/artboard.hpp"
 #include "rive/animation/linear_animation_instance.hpp"
@@ -14,6 +16,11 @@ MainScene::MainScene()
 
 MainScene::~MainScene()
 {
+    if (_loadRequest) _loadRequest->cancel();
+    _pipeline.reset();
+    if (_instance) {
+        AxmolRiveCache::getInstance()->recycleInstance(_scheduler.release(_instance));
+    }
     if (_touchListener)
         _eventDispatcher->removeEventListener(_touchListener);
 }
@@ -43,73 +50,17 @@ bool MainScene::init()
     _riveContainer->setPositionY(visibleSize.height);
 
     // 3. Initialize Rive
-    _riveFactory = std::make_unique<AxmolFactory>();
     _riveRenderer = std::make_unique<AxmolRenderer>(_riveContainer);
+    // Paths smaller than a quarter of a point can't visibly change the frame
+    _riveRenderer->setMinCoverage(0.25f);
 
-    // 4. Load .riv File
-    auto fileUtils = FileUtils::getInstance();
-    std::string fullPath = fileUtils->fullPathForFilename("emojis.riv");
-
-    if (fullPath.empty()) {
-        AXLOGD("Error: marty_site.riv not found!");
-    } else {
-        auto data = fileUtils->getDataFromFile(fullPath);
-        if (!data.isNull()) {
-            rive::Span<const uint8_t> bytes(data.getBytes(), data.getSize());
-
-            rive::ImportResult result;
-            _riveFile = rive::File::import(bytes, _riveFactory.get(), &result);
-            
-            if (_riveFile) {
-                // Log File Contents
-                AXLOGD("Rive File Loaded. Artboard Count: %zu", _riveFile->artboardCount());
-                for (size_t i = 0; i < _riveFile->artboardCount(); ++i) {
-                    auto ab = _riveFile->artboardAt(i);
-                    AXLOGD("  Artboard [%zu]: %s", i, ab->name().c_str());
-                }
-
-                _artboard = _riveFile->artboardDefault();
-                if (_artboard) {
-                    // Load initial artboard using our helper (handles logic)
-                    loadArtboard(0);
-                    
-                    AXLOGD("Loaded Default Artboard: %s", _artboard->name().c_str());
-                    
-                    // Log Animations and State Machines
-                    AXLOGD("  Animation Count: %zu", _artboard->animationCount());
-                    for (size_t i = 0; i < _artboard->animationCount(); ++i) {
-                        AXLOGD("    Anim [%zu]: %s", i, _artboard->animationNameAt(i).c_str());
-                    }
-                    
-                    AXLOGD("  StateMachine Count: %zu", _artboard->stateMachineCount());
-                    for (size_t i = 0; i < _artboard->stateMachineCount(); ++i) {
-                        AXLOGD("    SM [%zu]: %s", i, _artboard->stateMachineNameAt(i).c_str());
-                    }
-
-                    // Advance artboard to initial state
-                    _artboard->advance(0.0f);
-
-                    // Try to load the first State Machine
-                    _stateMachine = _artboard->stateMachineAt(0);
-                    if (_stateMachine) {
-                        AXLOGD("State Machine loaded successfully!");
-                    } else {
-                        // Fallback: Try to load the first animation
-                        _animInstance = _artboard->animationAt(0);
-                        if (_animInstance) {
-                            AXLOGD("No State Machine, playing animation: %s", _animInstance->name().c_str());
-                        } else {
-                            AXLOGD("No State Machine and no Animation found.");
-                        }
-                    }
-
-                    AXLOGD("Rive file loaded successfully!");
-                }
-            } else {
-                AXLOGD("Failed to import Rive file.");
-            }
-        }
-    }
+    // 4. Load .riv File on the loader thread, shared with anything else playing it
+    _loadRequest = AxmolRiveCache::getInstance()->loadFileAsync(
+        "emojis.riv",
+        [this](rive::rcp<rive::File> file, std::unique_ptr<AxmolRiveInstance> artboard) {
+            onRiveLoaded(std::move(file), std::move(artboard));
+        },
+        [](float progress) { AXLOGD("Loading Rive file: %d%%", static_cast<int>(progress * 100.0f)); });
 
     // 5. Close Button
     auto closeItem = MenuItemImage::create("CloseNormal.png", "CloseSelected.png",
@@ -137,84 +88,149 @@ bool MainScene::init()
 
 void MainScene::update(float delta)
 {
-    if (_artboard && _riveRenderer) {
-        // Prepare for new frame
-        _riveRenderer->startFrame();
-
-        // Advance animation
-        if (_stateMachine) {
-            _stateMachine->advance(delta);
-        } else if (_animInstance) {
-            _animInstance->advance(delta);
-            _animInstance->apply();
-            _artboard->advance(delta); // Still needed to update components
-        } else {
-            _artboard->advance(delta);
-        }
+    if (!_instance || !_riveRenderer) return;
+
+    if (_pipeline) {
+        // Frame recorded during the last update, then the next one overlaps with this frame's render
+        _pipeline->submit();
+        _viewSize = _director->getVisibleSize();
+        _pipeline->kick(delta);
+        return;
+    }
 
-        // Center and scale the artboard to fit the screen
-        auto visibleSize = _director->getVisibleSize();
+    _viewSize = _director->getVisibleSize();
+    _riveRenderer->beginRecording();
+    if (recordFrame(_riveRenderer.get(), delta)) {
+        _riveRenderer->finishRecording();
+        _riveRenderer->submit();
+    }
+}
 
-        _riveRenderer->save();
-        _riveRenderer->align(rive::Fit::contain, rive::Alignment::center,
-                             rive::AABB(0, 0, visibleSize.width, visibleSize.height),
-                             _artboard->bounds());
+bool MainScene::recordFrame(AxmolRenderer* renderer, float delta)
+{
+    // Center and scale the artboard to fit the screen
+    _instance->frame = rive::AABB(0, 0, _viewSize.width, _viewSize.height);
+
+    // Advance animation, each advance reports whether anything changed or is still moving
+    bool changed = _scheduler.advance(delta);
+
+    auto bounds = _instance->artboard->bounds();
+    bool viewChanged = _viewSize.width != _drawnViewSize.width || _viewSize.height != _drawnViewSize.height ||
+                       bounds.minX != _drawnBounds.minX || bounds.minY != _drawnBounds.minY ||
+                       bounds.maxX != _drawnBounds.maxX || bounds.maxY != _drawnBounds.maxY;
+
+    // Idle: keep last frame's output as it is. The frame where advance settles can still
+    // carry the final values, so one more frame is drawn after the last change.
+    bool redraw = changed || _wasChanging || viewChanged || _needsRedraw;
+    _wasChanging = changed;
+    if (!redraw) return false;
+    _needsRedraw = false;
+    _drawnViewSize = _viewSize;
+    _drawnBounds = bounds;
+
+    // Anything outside the screen is culled
+    renderer->setCullRect(rive::AABB(0, 0, _viewSize.width, _viewSize.height));
+    _scheduler.draw(renderer);
+    return true;
+}
 
-        _artboard->draw(_riveRenderer.get());
-        _riveRenderer->restore();
+void MainScene::setPipelined(bool enabled)
+{
+    if (enabled == (_pipeline != nullptr) || !_riveRenderer) return;
+    if (enabled) {
+        _pipeline = std::make_unique<AxmolFramePipeline>(
+            _riveRenderer.get(), [this](AxmolRenderer* renderer, float dt) { return recordFrame(renderer, dt); });
+    } else {
+        // A frame recorded but never submitted is dropped, the next update draws again
+        _pipeline.reset();
+        _needsRedraw = true;
     }
 }
 
+void MainScene::syncRive()
+{
+    if (_pipeline) _pipeline->sync();
+}
+
 void MainScene::menuCloseCallback(ax::Object* sender)
 {
     _director->end();
 }
 
+// Touch location to the artboard space of the shown instance (Axmol Y is up, Rive Y is down)
+static bool touchToArtboard(const AxmolRiveInstance* instance, ax::Touch* touch, float viewHeight,
+                            rive::Vec2D& out) {
+    auto location = touch->getLocation();
+    return instance->toArtboard(rive::Vec2D(location.x, viewHeight - location.y), out);
+}
+
 void MainScene::onTouchesBegan(const std::vector<ax::Touch*>& touches, ax::Event* event) {
-    if (_stateMachine && !touches.empty()) {
-        auto touch = touches[0];
-        auto location = touch->getLocation();
-        // Convert to Rive coordinates (which are rendered centered/scaled)
-        // This is tricky because we used 'align' in draw.
-        // Ideally, we should store the transform used in 'draw'.
-        // For now, let's assume we can just pass screen coordinates if we didn't align?
-        // But we DID align.
-        // To do this properly, we need the inverse of the alignment transform.
-        // Rive's 'computeAlignment' returns a Mat2D. We should store it.
-
-        // Re-calculate alignment transform
-        auto visibleSize = _director->getVisibleSize();
-        rive::Mat2D transform = rive::computeAlignment(
-            rive::Fit::contain, rive::Alignment::center,
-            rive::AABB(0, 0, visibleSize.width, visibleSize.height),
-            _artboard->bounds()
-        );
-
-        rive::Mat2D inverse;
-        if (transform.invert(&inverse)) {
-            rive::Vec2D localPos = inverse * rive::Vec2D(location.x, visibleSize.height - location.y); // Axmol Y is up, Rive Y is down
-            _stateMachine->pointerDown(localPos);
+    syncRive();
+    if (_instance && _instance->stateMachine && !touches.empty()) {
+        // Inverse of the alignment the instance is drawn with
+        rive::Vec2D localPos;
+        if (touchToArtboard(_instance, touches[0], _director->getVisibleSize().height, localPos)) {
+            _instance->stateMachine->pointerDown(localPos);
         }
     }
 }
 
 void MainScene::onTouchesMoved(const std::vector<ax::Touch*>& touches, ax::Event* event) {
-    if (_stateMachine && !touches.empty()) {
-        auto touch = touches[0];
-        auto location = touch->getLocation();
+    syncRive();
+    if (_instance && _instance->stateMachine && !touches.empty()) {
+        rive::Vec2D localPos;
+        if (touchToArtboard(_instance, touches[0], _director->getVisibleSize().height, localPos)) {
+            _instance->stateMachine->pointerMove(localPos);
+        }
+    }
+}
 
-        auto visibleSize = _director->getVisibleSize();
-        rive::Mat2D transform = rive::computeAlignment(
-            rive::Fit::contain, rive::Alignment::center,
-            rive::AABB(0, 0, visibleSize.width, visibleSize.height),
-            _artboard->bounds()
-        );
-
-        rive::Mat2D inverse;
-        if (transform.invert(&inverse)) {
-            rive::Vec2D localPos = inverse * rive::Vec2D(location.x, visibleSize.height - location.y);
-            _stateMachine->pointerMove(localPos);
+void MainScene::onRiveLoaded(rive::rcp<rive::File> file, std::unique_ptr<AxmolRiveInstance> firstArtboard) {
+    _loadRequest.reset();
+    _riveFile = std::move(file);
+    if (_riveFile) {
+        // Log File Contents
+        AXLOGD("Rive File Loaded. Artboard Count: %zu", _riveFile->artboardCount());
+        for (size_t i = 0; i < _riveFile->artboardCount(); ++i) {
+            auto ab = _riveFile->artboard(i);
+            AXLOGD("  Artboard [%zu]: %s", i, ab->name().c_str());
+        }
+
+        // The first artboard comes instanced from the loader, other ones through loadArtboard
+        if (_pipeline) _pipeline->discard();
+        _currentArtboardIndex = 0;
+        _instance = _scheduler.add(std::move(firstArtboard));
+        if (_instance) {
+            auto visibleSize = _director->getVisibleSize();
+            _instance->frame = rive::AABB(0, 0, visibleSize.width, visibleSize.height);
+            _needsRedraw = true;
+
+            auto artboard = _instance->artboard.get();
+            AXLOGD("Loaded Artboard: %s", artboard->name().c_str());
+            
+            // Log Animations and State Machines
+            AXLOGD("  Animation Count: %zu", artboard->animationCount());
+            for (size_t i = 0; i < artboard->animationCount(); ++i) {
+                AXLOGD("    Anim [%zu]: %s", i, artboard->animationNameAt(i).c_str());
+            }
+            
+            AXLOGD("  StateMachine Count: %zu", artboard->stateMachineCount());
+            for (size_t i = 0; i < artboard->stateMachineCount(); ++i) {
+                AXLOGD("    SM [%zu]: %s", i, artboard->stateMachineNameAt(i).c_str());
+            }
+
+            if (_instance->stateMachine) {
+                AXLOGD("State Machine loaded successfully!");
+            } else if (_instance->animation) {
+                AXLOGD("No State Machine, playing animation: %s", _instance->animation->name().c_str());
+            } else {
+                AXLOGD("No State Machine and no Animation found.");
+            }
+
+            AXLOGD("Rive file loaded successfully!");
         }
+    } else {
+        AXLOGD("Failed to import Rive file.");
     }
 }
 
@@ -225,50 +241,38 @@ void MainScene::loadArtboard(int index) {
         index = 0;
     }
     _currentArtboardIndex = index;
+    // The frame in flight draws the artboard about to be destroyed
+    if (_pipeline) _pipeline->discard();
     
-    _artboard = _riveFile->artboardAt(index);
-    if (!_artboard) return;
-    
-    AXLOGD("Switching to Artboard [%d]: %s", index, _artboard->name().c_str());
-    
-    _artboard->advance(0.0f);
-    
-    // Reset State Machine / Animation
-    _stateMachine = _artboard->stateMachineAt(0);
-    if (!_stateMachine) {
-        _stateMachine = _artboard->defaultStateMachine();
+    // The previous artboard goes back to the pool, switching back to it later doesn't clone it again.
+    // The State Machine / Animation is always new.
+    auto cache = AxmolRiveCache::getInstance();
+    if (_instance) {
+        cache->recycleInstance(_scheduler.release(_instance));
     }
+    _instance = _scheduler.add(cache->acquireInstance(_riveFile, index));
+    if (!_instance) return;
     
-    _animInstance = nullptr;
-    if (!_stateMachine) {
-        auto anim = _artboard->animationAt(0);
-        if (anim) {
-            _animInstance = _artboard->animationAt(0); // Correct way
-        }
-    }
+    AXLOGD("Switching to Artboard [%d]: %s", index, _instance->artboard->name().c_str());
+    
+    auto visibleSize = _director->getVisibleSize();
+    _instance->frame = rive::AABB(0, 0, visibleSize.width, visibleSize.height);
+    _needsRedraw = true;
     
     // Reset Renderer State?
     // AxmolRenderer persists, but its internal state (clipping) is per-frame.
-    // The DrawNode is cleared every frame in update().
+    // Its single mesh node is cleared every frame, a different artboard needs no extra work.
 }
 
 void MainScene::onTouchesEnded(const std::vector<ax::Touch*>& touches, ax::Event* event) {
+    syncRive();
     if (!touches.empty()) {
         // If we have a state machine, pass input first
-        if (_stateMachine) {
-             auto touch = touches[0];
-             auto location = touch->getLocation();
-             auto visibleSize = _director->getVisibleSize();
-             rive::Mat2D transform = rive::computeAlignment(
-                 rive::Fit::contain, rive::Alignment::center,
-                 rive::AABB(0, 0, visibleSize.width, visibleSize.height),
-                 _artboard->bounds()
-             );
-             rive::Mat2D inverse;
-             if (transform.invert(&inverse)) {
-                 rive::Vec2D localPos = inverse * rive::Vec2D(location.x, visibleSize.height - location.y);
-                 _stateMachine->pointerUp(localPos);
-             }
+        if (_instance && _instance->stateMachine) {
+            rive::Vec2D localPos;
+            if (touchToArtboard(_instance, touches[0], _director->getVisibleSize().height, localPos)) {
+                _instance->stateMachine->pointerUp(localPos);
+            }
         }
         
         // Check if touch is in a "Next" button area (e.g., bottom right) or just cycle
@@ -4,6 +4,8 @@
 #include "rive/refcnt.hpp" // Include for rive::rcp
 #include "rive/animation/state_machine_instance.hpp"
 #include "rive/animation/linear_animation_instance.hpp" // Added
+#include "rive/math/aabb.hpp"
+#include "AxmolRiveScheduler.h"
 #include <memory>
 #include <vector>
 
@@ -16,7 +18,8 @@ namespace rive {
     class LinearAnimationInstance; // Added
 }
 class AxmolRenderer;
-class AxmolFactory;
+class AxmolFramePipeline;
+class AxmolRiveLoadRequest;
 
 class MainScene : public ax::Scene
 {
@@ -33,22 +36,42 @@ public:
     // Helper to load artboard by index
     void loadArtboard(int index);
 
+    // Advance and record the next frame on a background thread while the engine renders the
+    // current one. Adds one frame of latency. Off by default.
+    void setPipelined(bool enabled);
+
     MainScene();
     ~MainScene() override;
 
 private:
+    // Advances and records one frame into the renderer, false when idle and nothing was recorded
+    bool recordFrame(AxmolRenderer* renderer, float delta);
+    // Waits for the pipelined frame in flight, before touching the artboard from this thread
+    void syncRive();
+    // Takes the .riv and its first artboard once loaded, the file is null when it failed
+    void onRiveLoaded(rive::rcp<rive::File> file, std::unique_ptr<AxmolRiveInstance> artboard);
+
     int _currentArtboardIndex = 0;
     ax::Node* _riveContainer = nullptr;
     
-    std::unique_ptr<rive::ArtboardInstance> _artboard;
-    std::unique_ptr<rive::Scene> _riveScene; // For state machines or animations
-    std::unique_ptr<rive::StateMachineInstance> _stateMachine;
-    std::unique_ptr<rive::LinearAnimationInstance> _animInstance; // Fallback animation
+    // Owns the artboard and its state machine (or fallback animation)
+    AxmolRiveScheduler _scheduler;
+    AxmolRiveInstance* _instance = nullptr; // The artboard shown, owned by _scheduler
     std::unique_ptr<AxmolRenderer> _riveRenderer;
-    std::unique_ptr<AxmolFactory> _riveFactory;
     
-    // Rive File - use rcp
+    // Rive File - use rcp, shared through AxmolRiveCache
     rive::rcp<rive::File> _riveFile;
+    std::shared_ptr<AxmolRiveLoadRequest> _loadRequest; // Until _riveFile is loaded
+
+    // Set while pipelined, destroyed before the renderer and the scheduler it uses
+    std::unique_ptr<AxmolFramePipeline> _pipeline;
+    ax::Size _viewSize; // Visible size for the frame being recorded
+
+    // Idle detection: what the retained output was drawn for
+    bool _needsRedraw = true;
+    bool _wasChanging = true;
+    ax::Size _drawnViewSize;
+    rive::AABB _drawnBounds;
     
     ax::EventListenerTouchAllAtOnce* _touchListener = nullptr;
 };
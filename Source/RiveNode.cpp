@@ -0,0 +1,146 @@
+#include "RiveNode.h"
+#include "AxmolRive.h"
+#include "AxmolRiveCache.h"
+
+namespace ax {
+
+RiveNode* RiveNode::create(std::string_view path, std::string_view artboard, std::string_view stateMachine) {
+    return createWithFile(AxmolRiveCache::getInstance()->getFile(path), artboard, stateMachine);
+}
+
+RiveNode* RiveNode::createWithFile(rive::rcp<rive::File> file, std::string_view artboard,
+                                   std::string_view stateMachine) {
+    auto node = new RiveNode();
+    if (node->initWithFile(std::move(file), artboard, stateMachine)) {
+        node->autorelease();
+        return node;
+    }
+    delete node;
+    return nullptr;
+}
+
+RiveNode::RiveNode() {}
+
+RiveNode::~RiveNode() {
+    setTouchEnabled(false);
+    recycleInstance();
+}
+
+bool RiveNode::initWithFile(rive::rcp<rive::File> file, std::string_view artboard, std::string_view stateMachine) {
+    if (!file || !Node::init()) {
+        return false;
+    }
+    _file = std::move(file);
+
+    // Same flip as MainScene's container: Rive is top-left (y down), Axmol bottom-left (y up)
+    _content = Node::create();
+    _content->setScaleY(-1.0f);
+    addChild(_content);
+    _renderer = std::make_unique<AxmolRenderer>(_content);
+
+    if (!setArtboard(artboard, stateMachine)) {
+        return false;
+    }
+    auto bounds = _instance->artboard->bounds();
+    setContentSize(Size(bounds.width(), bounds.height()));
+
+    scheduleUpdate();
+    return true;
+}
+
+bool RiveNode::setArtboard(std::string_view artboard, std::string_view stateMachine) {
+    int index = AxmolRiveCache::findArtboard(*_file, artboard);
+    if (index < 0) {
+        AXLOGD("RiveNode: no artboard named %s", std::string(artboard).c_str());
+        return false;
+    }
+    auto instance = AxmolRiveCache::getInstance()->acquireInstance(_file, index, stateMachine);
+    if (!instance) return false;
+
+    if (_instance) {
+        instance->fit = _instance->fit;
+        instance->alignment = _instance->alignment;
+    }
+    recycleInstance();
+    _instance = std::move(instance);
+    _instance->frame = rive::AABB(0.0f, 0.0f, _contentSize.width, _contentSize.height);
+    _needsRedraw = true;
+    return true;
+}
+
+void RiveNode::recycleInstance() {
+    if (_instance) {
+        AxmolRiveCache::getInstance()->recycleInstance(std::move(_instance));
+    }
+}
+
+void RiveNode::setFit(rive::Fit fit, rive::Alignment alignment) {
+    if (!_instance) return;
+    _instance->fit = fit;
+    _instance->alignment = alignment;
+    _needsRedraw = true;
+}
+
+void RiveNode::setContentSize(const Size& size) {
+    Node::setContentSize(size);
+    if (_content) _content->setPositionY(size.height);
+    if (_instance) _instance->frame = rive::AABB(0.0f, 0.0f, size.width, size.height);
+    _needsRedraw = true;
+}
+
+void RiveNode::update(float delta) {
+    if (!_instance) return;
+
+    bool changed = _instance->advance(delta);
+    // One more frame after the last change, the settling advance can still carry final values
+    bool redraw = changed || _wasChanging || _needsRedraw;
+    _wasChanging = changed;
+    if (!redraw) return;
+    _needsRedraw = false;
+
+    _renderer->startFrame();
+    _instance->draw(_renderer.get());
+    _renderer->endFrame();
+}
+
+bool RiveNode::toArtboard(const Vec2& point, rive::Vec2D& out) const {
+    return _instance && _instance->toArtboard(rive::Vec2D(point.x, _contentSize.height - point.y), out);
+}
+
+void RiveNode::pointerDown(const Vec2& point) {
+    rive::Vec2D local;
+    if (getStateMachine() && toArtboard(point, local)) getStateMachine()->pointerDown(local);
+}
+
+void RiveNode::pointerMove(const Vec2& point) {
+    rive::Vec2D local;
+    if (getStateMachine() && toArtboard(point, local)) getStateMachine()->pointerMove(local);
+}
+
+void RiveNode::pointerUp(const Vec2& point) {
+    rive::Vec2D local;
+    if (getStateMachine() && toArtboard(point, local)) getStateMachine()->pointerUp(local);
+}
+
+void RiveNode::setTouchEnabled(bool enabled) {
+    if (enabled == isTouchEnabled()) return;
+    if (!enabled) {
+        _eventDispatcher->removeEventListener(_touchListener);
+        _touchListener = nullptr;
+        return;
+    }
+
+    _touchListener = EventListenerTouchOneByOne::create();
+    _touchListener->onTouchBegan = [this](Touch* touch, Event*) {
+        Vec2 point = convertToNodeSpace(touch->getLocation());
+        if (!getStateMachine() || !Rect(Vec2::ZERO, _contentSize).containsPoint(point)) return false;
+        pointerDown(point);
+        return true;
+    };
+    _touchListener->onTouchMoved = [this](Touch* touch, Event*) { pointerMove(convertToNodeSpace(touch->getLocation())); };
+    _touchListener->onTouchEnded = [this](Touch* touch, Event*) { pointerUp(convertToNodeSpace(touch->getLocation())); };
+    _touchListener->onTouchCancelled = _touchListener->onTouchEnded;
+    _eventDispatcher->addEventListenerWithSceneGraphPriority(_touchListener, this);
+}
+
+} // namespace ax
@@ -0,0 +1,71 @@
+#ifndef _RIVE_NODE_H_
+#define _RIVE_NODE_H_
+
+#include "axmol/axmol.h"
+#include "AxmolRiveScheduler.h"
+
+#include <memory>
+#include <string_view>
+
+class AxmolRenderer;
+
+namespace ax {
+
+// Plays one artboard of a .riv like any other node. Files come from AxmolRiveCache, so any
+// number of nodes on the same file import it once, and their artboard instances go back to
+// the cache's pool when the node is destroyed or switches artboard.
+//
+// The artboard is fitted into the content size (the artboard's own size until set), with the
+// node's origin at the bottom left like every Axmol node.
+class RiveNode : public Node {
+public:
+    // Artboard 'artboard' (the first one when empty) of the .riv at 'path', playing 'stateMachine'
+    // (the first one when empty, else the first animation)
+    static RiveNode* create(std::string_view path, std::string_view artboard = {}, std::string_view stateMachine = {});
+    // Same for a file already imported with AxmolRiveCache's factory
+    static RiveNode* createWithFile(rive::rcp<rive::File> file, std::string_view artboard = {},
+                                    std::string_view stateMachine = {});
+
+    RiveNode();
+    ~RiveNode() override;
+
+    bool initWithFile(rive::rcp<rive::File> file, std::string_view artboard, std::string_view stateMachine);
+
+    // Switches to another artboard of the same file, the current instance is recycled
+    bool setArtboard(std::string_view artboard, std::string_view stateMachine = {});
+    void setFit(rive::Fit fit, rive::Alignment alignment = rive::Alignment::center);
+
+    const rive::rcp<rive::File>& getFile() const { return _file; }
+    AxmolRiveInstance* getRiveInstance() const { return _instance.get(); }
+    rive::StateMachineInstance* getStateMachine() const { return _instance ? _instance->stateMachine.get() : nullptr; }
+
+    // Touches starting inside the node go to the state machine, off by default
+    void setTouchEnabled(bool enabled);
+    bool isTouchEnabled() const { return _touchListener != nullptr; }
+    // Pointer events in node space
+    void pointerDown(const Vec2& point);
+    void pointerMove(const Vec2& point);
+    void pointerUp(const Vec2& point);
+
+    void update(float delta) override;
+    void setContentSize(const Size& size) override;
+
+private:
+    // Node space (y up) to artboard space, false outside the artboard's transform
+    bool toArtboard(const Vec2& point, rive::Vec2D& out) const;
+    void recycleInstance();
+
+    rive::rcp<rive::File> _file;
+    std::unique_ptr<AxmolRiveInstance> _instance;
+    std::unique_ptr<AxmolRenderer> _renderer;
+    Node* _content = nullptr; // Flipped to Rive's y down, holds the renderer's mesh node
+    EventListenerTouchOneByOne* _touchListener = nullptr;
+
+    // Idle detection, like MainScene
+    bool _needsRedraw = true;
+    bool _wasChanging = true;
+};
+
+} // namespace ax
+
+#endif // _RIVE_NODE_H_
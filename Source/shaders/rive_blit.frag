@@ -0,0 +1,13 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+// Same size and viewport as the target, so pixels line up in every backend's own orientation
+layout(binding = 0) uniform sampler2D u_tex0;
+
+void main()
+{
+    FragColor = texelFetch(u_tex0, ivec2(gl_FragCoord.xy), 0);
+}
@@ -0,0 +1,9 @@
+#version 310 es
+
+// Full target quad in clip space, used by AxmolMeshNode to copy and composite its layer
+layout(location = POSITION) in vec2 a_position;
+
+void main()
+{
+    gl_Position = vec4(a_position, 0.0, 1.0);
+}
@@ -0,0 +1,18 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+// White with the draw's opacity
+layout(location = COLOR0) in vec4 v_color;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+// Atlas page, premultiplied so filtering doesn't darken transparent edges
+layout(binding = 0) uniform sampler2D u_tex0;
+
+void main()
+{
+    // Already premultiplied like rive_path's output, the opacity scales all four channels
+    FragColor = texture(u_tex0, v_texCoord) * v_color.a;
+}
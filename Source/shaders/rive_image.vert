@@ -0,0 +1,37 @@
+#version 310 es
+
+// Must match AxmolMeshNode::MaxBatchSlots
+#define MAX_SLOTS 16
+
+// Same transform as rive_path.vert, with a texture coordinate instead of a color
+layout(location = POSITION) in vec2 a_position;
+layout(location = TEXCOORD0) in vec2 a_texCoord;
+// Draw of the batch the vertex belongs to
+layout(location = TEXCOORD1) in float a_slot;
+
+layout(location = TEXCOORD0) out vec2 v_texCoord;
+// White with the draw's opacity
+layout(location = COLOR0) out vec4 v_color;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // Per slot. Rive Mat2D columns: (xx, xy), (yx, yy)
+    vec4 u_riveAffine[MAX_SLOTS];
+    // Per slot. Rive Mat2D translation in xy
+    vec4 u_riveTranslate[MAX_SLOTS];
+    // Per slot. Image uv to atlas page uv: scale in xy, offset in zw
+    vec4 u_uvTransform[MAX_SLOTS];
+    // Per slot
+    vec4 u_color[MAX_SLOTS];
+};
+
+void main()
+{
+    int slot = int(a_slot + 0.5);
+    vec4 affine = u_riveAffine[slot];
+    vec2 pos = mat2(affine.xy, affine.zw) * a_position + u_riveTranslate[slot].xy;
+    gl_Position = u_MVPMatrix * vec4(pos, 0.0, 1.0);
+    vec4 uvTransform = u_uvTransform[slot];
+    v_texCoord = a_texCoord * uvTransform.xy + uvTransform.zw;
+    v_color = u_color[slot];
+}
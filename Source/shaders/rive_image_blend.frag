@@ -0,0 +1,122 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+// rive_image.frag for the blend modes fixed-function blending can't draw, see rive_path_blend.frag
+
+layout(location = TEXCOORD0) in vec2 v_texCoord;
+// White with the draw's opacity
+layout(location = COLOR0) in vec4 v_color;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+// Atlas page, premultiplied
+layout(binding = 0) uniform sampler2D u_tex0;
+// Copy of the layer under the draw, see AxmolMeshNode
+layout(binding = 1) uniform sampler2D u_backdrop;
+
+layout(std140) uniform fs_ub {
+    // x: blend mode, see blendColor
+    vec4 u_blendMode;
+};
+
+// Separable blend functions of the W3C compositing spec, 'b' the backdrop and 's' the source.
+// Modes are numbered by AxmolMeshNode::blendShaderMode.
+float hardLight(float b, float s)
+{
+    float s2 = 2.0 * s;
+    return s <= 0.5 ? b * s2 : b + (s2 - 1.0) - b * (s2 - 1.0);
+}
+
+float blendChannel(int mode, float b, float s)
+{
+    if (mode == 1) // multiply
+        return b * s;
+    if (mode == 2) // overlay
+        return hardLight(s, b);
+    if (mode == 3) // darken
+        return min(b, s);
+    if (mode == 4) // lighten
+        return max(b, s);
+    if (mode == 5) // colorDodge
+        return b <= 0.0 ? 0.0 : (s >= 1.0 ? 1.0 : min(1.0, b / (1.0 - s)));
+    if (mode == 6) // colorBurn
+        return b >= 1.0 ? 1.0 : (s <= 0.0 ? 0.0 : 1.0 - min(1.0, (1.0 - b) / s));
+    if (mode == 7) // hardLight
+        return hardLight(b, s);
+    if (mode == 8) // softLight
+    {
+        if (s <= 0.5)
+            return b - (1.0 - 2.0 * s) * b * (1.0 - b);
+        float d = b <= 0.25 ? ((16.0 * b - 12.0) * b + 4.0) * b : sqrt(b);
+        return b + (2.0 * s - 1.0) * (d - b);
+    }
+    if (mode == 9) // difference
+        return abs(b - s);
+    return s;
+}
+
+float luminosity(vec3 c)
+{
+    return dot(c, vec3(0.3, 0.59, 0.11));
+}
+
+vec3 setLuminosity(vec3 c, float l)
+{
+    c += l - luminosity(c);
+    // ClipColor
+    l = luminosity(c);
+    float lo = min(c.r, min(c.g, c.b));
+    float hi = max(c.r, max(c.g, c.b));
+    if (lo < 0.0)
+        c = l + (c - l) * l / (l - lo);
+    if (hi > 1.0)
+        c = l + (c - l) * (1.0 - l) / (hi - l);
+    return c;
+}
+
+float saturation(vec3 c)
+{
+    return max(c.r, max(c.g, c.b)) - min(c.r, min(c.g, c.b));
+}
+
+vec3 setSaturation(vec3 c, float s)
+{
+    float lo = min(c.r, min(c.g, c.b));
+    float range = max(c.r, max(c.g, c.b)) - lo;
+    // Scaling every channel from the minimum moves the middle one like SetSat, and sends the
+    // maximum to s and the minimum to 0
+    return range > 0.0 ? (c - lo) * s / range : vec3(0.0);
+}
+
+// B(backdrop, source) of any mode, on straight colors
+vec3 blendColor(int mode, vec3 b, vec3 s)
+{
+    if (mode == 10) // hue
+        return setLuminosity(setSaturation(s, saturation(b)), luminosity(b));
+    if (mode == 11) // saturation
+        return setLuminosity(setSaturation(b, saturation(s)), luminosity(b));
+    if (mode == 12) // color
+        return setLuminosity(s, luminosity(b));
+    if (mode == 13) // luminosity
+        return setLuminosity(b, luminosity(s));
+    return vec3(blendChannel(mode, b.r, s.r), blendChannel(mode, b.g, s.g), blendChannel(mode, b.b, s.b));
+}
+
+// Straight source 's' with alpha 'a' composited over the backdrop copy, premultiplied like
+// AxmolSoftwareSink: source where the backdrop is clear, backdrop where the source is clear, B()
+// where both are opaque
+vec4 compositeOverBackdrop(vec3 s, float a)
+{
+    vec4 dst = texelFetch(u_backdrop, ivec2(gl_FragCoord.xy), 0);
+    vec3 b = dst.a > 0.0 ? min(dst.rgb / dst.a, vec3(1.0)) : vec3(0.0);
+    vec3 mixed = blendColor(int(u_blendMode.x), b, s);
+    return vec4(s * a * (1.0 - dst.a) + dst.rgb * (1.0 - a) + a * dst.a * mixed, a + dst.a * (1.0 - a));
+}
+
+void main()
+{
+    vec4 texel = texture(u_tex0, v_texCoord);
+    vec3 straight = texel.a > 0.0 ? texel.rgb / texel.a : vec3(0.0);
+    FragColor = compositeOverBackdrop(straight, texel.a * v_color.a);
+}
@@ -0,0 +1,72 @@
+#version 310 es
+precision highp float;
+precision highp int;
+
+// Must match AxmolGradientUniforms::MaxStops
+#define MAX_STOPS 16
+
+layout(location = COLOR0) in vec4 v_color;
+layout(location = TEXCOORD0) in vec2 v_localPos;
+
+layout(location = SV_Target0) out vec4 FragColor;
+
+layout(std140) uniform fs_ub {
+    // x: 0 none, 1 linear, 2 radial. y: stop count
+    vec4 u_gradientType;
+    // Linear: start in xy, end in zw. Radial: center in xy, radius in z
+    vec4 u_gradientPoints;
+    // Four offsets per vec4
+    vec4 u_stopOffsets[MAX_STOPS / 4];
+    vec4 u_stopColors[MAX_STOPS];
+};
+
+float stopOffset(int i)
+{
+    return u_stopOffsets[i / 4][i % 4];
+}
+
+vec4 gradientColor()
+{
+    float t;
+    if (u_gradientType.x < 1.5)
+    {
+        vec2 d = u_gradientPoints.zw - u_gradientPoints.xy;
+        float lenSq = dot(d, d);
+        t = lenSq > 0.0001 ? dot(v_localPos - u_gradientPoints.xy, d) / lenSq : 0.0;
+    }
+    else
+    {
+        float radius = u_gradientPoints.z;
+        t = radius > 0.0001 ? distance(v_localPos, u_gradientPoints.xy) / radius : 0.0;
+    }
+    t = clamp(t, 0.0, 1.0);
+
+    int count = int(u_gradientType.y);
+    if (t <= stopOffset(0))
+        return u_stopColors[0];
+
+    for (int i = 1; i < MAX_STOPS; ++i)
+    {
+        if (i >= count)
+            break;
+        float prev = stopOffset(i - 1);
+        float next = stopOffset(i);
+        if (t <= next)
+        {
+            float range = next - prev;
+            float localT = range > 0.0 ? (t - prev) / range : 1.0;
+            return mix(u_stopColors[i - 1], u_stopColors[i], localT);
+        }
+    }
+    return u_stopColors[count - 1];
+}
+
+void main()
+{
+    // Paint color and vertex shading, combined by the vertex stage
+    vec4 color = v_color;
+    if (u_gradientType.x > 0.5)
+        color *= gradientColor();
+    // Premultiplied, every blend state of AxmolMeshNode expects it
+    FragColor = vec4(color.rgb * color.a, color.a);
+}
@@ -0,0 +1,34 @@
+#version 310 es
+
+// Must match AxmolMeshNode::MaxBatchSlots
+#define MAX_SLOTS 16
+
+// Rive path vertices stay in local space, the Mat2D of the draw is applied here
+layout(location = POSITION) in vec2 a_position;
+layout(location = COLOR0) in vec4 a_color;
+// Draw of the batch the vertex belongs to
+layout(location = TEXCOORD1) in float a_slot;
+
+layout(location = COLOR0) out vec4 v_color;
+// Gradients are defined in the path's local space
+layout(location = TEXCOORD0) out vec2 v_localPos;
+
+layout(std140) uniform vs_ub {
+    mat4 u_MVPMatrix;
+    // Per slot. Rive Mat2D columns: (xx, xy), (yx, yy)
+    vec4 u_riveAffine[MAX_SLOTS];
+    // Per slot. Rive Mat2D translation in xy
+    vec4 u_riveTranslate[MAX_SLOTS];
+    // Per slot paint color, vertex color carries per-vertex shading
+    vec4 u_color[MAX_SLOTS];
+};
+
+void main()
+{
+    int slot = int(a_slot + 0.5);
+    vec4 affine = u_riveAffine[slot];
+    vec2 pos = mat2(affine.xy, affine.zw) * a_position + u_riveTranslate[slot].xy;
+    gl_Position = u_MVPMatrix * vec4(pos, 0.0, 1.0);
+    v_color = a_color * u_color[slot];
+    v_localPos = a_position;
+}